@@ -7,60 +7,194 @@
 // -----------------------------------------------------------------------------
 
 #include "DetectorConstruction.h"
-#include "PrimaryGeneration.h"
-#include "RunAction.h"
-#include "EventAction.h"
-#include "TrackingAction.h"
-#include "SteppingAction.h"
-
-#include <G4RunManager.hh>
+#include "ActionInitialization.h"
+#include "EmDecayPhysicsList.h"
+#include "ImportanceWorld.h"
+#include "PassiveLimitsPhysics.h"
+#include "PhysicsTableCache.h"
+#include "StartupTiming.h"
+
+#include <G4RunManagerFactory.hh>
 #include <G4UImanager.hh>
 #include <G4VisExecutive.hh>
 #include <G4UIExecutive.hh>
-#include <FTFP_BERT_HP.hh>
-#include <G4EmStandardPhysics_option4.hh>
+#include <G4PhysListFactory.hh>
+#include <G4FastSimulationPhysics.hh>
+#include <G4GenericBiasingPhysics.hh>
+#include <G4GeometrySampler.hh>
+#include <G4ImportanceBiasing.hh>
+#include <G4ParallelWorldPhysics.hh>
 
 
 #include "Randomize.hh"
 #include "time.h"
 
+#include "TROOT.h"
+
+#include <cstdlib>
+#include <vector>
+
 
 
 int main(int argc, char** argv)
 {
-
-  //choose the Random engine
-  CLHEP::HepRandom::setTheEngine(new CLHEP::RanecuEngine());
+  StartupTiming::Record(StartupTiming::kStart);
+
+  // initialize ROOT up front, so that its cost shows in the startup timing.
+  // The worker threads each own a TFile, and the background writer fills
+  // the event tree from a thread of its own (/Inputs/writer_queue_depth),
+  // so ROOT must be thread safe before any of its objects is created
+  ROOT::EnableThreadSafety();
+  ROOT::GetROOT();
+  StartupTiming::Record(StartupTiming::kRootInit);
+
+  //choose the Random engine; MixMax lets PrimaryGeneration derive an
+  //independent stream per event from /Inputs/seed and the event ID
+  CLHEP::HepRandom::setTheEngine(new CLHEP::MixMaxRng());
   //set random seed with system time
   G4long seed = time(NULL);
   CLHEP::HepRandom::setTheSeed(seed);
 
 
-  // Detect interactive mode (if no arguments) and define UI session
+  // Parse the command line:
+  // directionality01 [-t n_threads] [--physics list] [--importance particle]
+  //                  [--force-collision particle]... [--fast-electrons] [macro]
+  //
+  G4String macro;
+  G4int n_threads = 0;
+  G4String physics_list_name;
+  G4String importance_particle;
+  std::vector<G4String> forced_collision_particles;
+  G4bool fast_electrons = false;
+  for (G4int i = 1; i < argc; ++i) {
+    G4String const arg = argv[i];
+    if ((arg == "-t" || arg == "--threads") && i + 1 < argc) {
+      n_threads = std::atoi(argv[++i]);
+    }
+    else if (arg == "--physics" && i + 1 < argc) {
+      physics_list_name = argv[++i];
+    }
+    else if (arg == "--importance" && i + 1 < argc) {
+      importance_particle = argv[++i];
+    }
+    else if (arg == "--force-collision" && i + 1 < argc) {
+      forced_collision_particles.push_back(argv[++i]);
+    }
+    else if (arg == "--fast-electrons") {
+      fast_electrons = true;
+    }
+    else {
+      macro = arg;
+    }
+  }
+
+  // Without an explicit thread count, use every core slurm gave us
+  if (n_threads == 0) {
+    char const * slurm_cpus = std::getenv("SLURM_CPUS_PER_TASK");
+    if (slurm_cpus) n_threads = std::atoi(slurm_cpus);
+  }
+
+  // Detect interactive mode (if no macro) and define UI session
   //
   G4UIExecutive* ui = 0;
-  if ( argc == 1 ) {
+  if ( macro.empty() ) {
     ui = new G4UIExecutive(argc, argv);
   }
 
-  // Construct the run manager and set the initialization classes
-  G4RunManager* run_manager = new G4RunManager();
+  // Construct the run manager and set the initialization classes.
+  // Anything above one thread selects the MT/tasking run manager (the type
+  // can still be forced through the G4RUN_MANAGER_TYPE environment variable).
+  G4RunManager* run_manager = 0;
+  if (n_threads > 1) {
+    run_manager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::Default, n_threads);
+  }
+  else {
+    run_manager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::Serial);
+  }
+
+  // Physics list: EM_RDM (electromagnetic physics and radioactive decay
+  // only) or any Geant4 reference list, from the command line or the
+  // QPIX_PHYSICS_LIST environment variable; FTFP_BERT_HP with
+  // G4EmStandardPhysics_option4 by default
+  if (physics_list_name.empty()) {
+    char const * env_physics_list = std::getenv("QPIX_PHYSICS_LIST");
+    physics_list_name = env_physics_list ? env_physics_list : "FTFP_BERT_HP_EMZ";
+  }
+
+  G4VModularPhysicsList* physics_list = 0;
+  G4PhysListFactory physics_list_factory;
+  if (physics_list_name == "EM_RDM") {
+    physics_list = new EmDecayPhysicsList();
+  }
+  else if (physics_list_factory.IsReferencePhysList(physics_list_name)) {
+    physics_list = physics_list_factory.GetReferencePhysList(physics_list_name);
+  }
+  else {
+    G4Exception("main()", "PhysicsList", FatalException,
+                ("Unknown physics list " + physics_list_name).c_str());
+  }
+  G4cout << "Physics list: " << physics_list_name << G4endl;
+
+  DetectorConstruction* detector = new DetectorConstruction();
+
+  // G4UserSpecialCuts, for the user limits of the passive volumes, if any
+  // are set
+  physics_list->RegisterPhysics(new PassiveLimitsPhysics(detector));
+
+  // Fast simulation of low-energy electrons in the target; without it the
+  // electrons carry no fast simulation process
+  if (fast_electrons) {
+    G4FastSimulationPhysics* fast_simulation_physics = new G4FastSimulationPhysics();
+    fast_simulation_physics->ActivateFastSimulation("e-");
+    physics_list->RegisterPhysics(fast_simulation_physics);
+    detector->EnableFastElectrons();
+  }
+
+  // Importance biasing of one particle type across the shield and wall
+  // layers, through a parallel world of importance cells
+  G4GeometrySampler* importance_sampler = 0;
+  if (!importance_particle.empty()) {
+    G4String const importance_world_name = "ImportanceWorld";
+    detector->RegisterParallelWorld(new ImportanceWorld(importance_world_name, detector));
+
+    importance_sampler = new G4GeometrySampler(importance_world_name, importance_particle);
+    importance_sampler->SetParallel(true);
+    physics_list->RegisterPhysics(new G4ImportanceBiasing(importance_sampler, importance_world_name));
+    physics_list->RegisterPhysics(new G4ParallelWorldPhysics(importance_world_name));
+  }
+
+  // Forced collision in the target of the given particle types, typically
+  // gammas and neutrons from the shield and wall; the weights end up in the
+  // particle_weight, hit_weight and voxel_weight branches; energies are
+  // never weighted
+  if (!forced_collision_particles.empty()) {
+    G4GenericBiasingPhysics* biasing_physics = new G4GenericBiasingPhysics();
+    for (auto const& particle : forced_collision_particles) {
+      biasing_physics->Bias(particle);
+      detector->AddForcedCollision(particle);
+    }
+    physics_list->RegisterPhysics(biasing_physics);
+  }
+
+  // Physics table cache (/physics_cache/directory or QPIX_PHYSICS_CACHE);
+  // registered last, its key covers everything added to the list above
+  G4String physics_configuration = physics_list_name + " importance:" + importance_particle + " force_collision:";
+  for (auto const& particle : forced_collision_particles) physics_configuration += particle + ",";
+  if (fast_electrons) physics_configuration += " fast_electrons";
+  physics_list->RegisterPhysics(new PhysicsTableCache(physics_configuration));
 
-  G4VModularPhysicsList* physics_list = new FTFP_BERT_HP();
-  physics_list->ReplacePhysics(new G4EmStandardPhysics_option4());
   run_manager->SetUserInitialization(physics_list);
 
-  run_manager->SetUserInitialization(new DetectorConstruction());
+  run_manager->SetUserInitialization(detector);
 
-  run_manager->SetUserAction(new PrimaryGeneration());
-  run_manager->SetUserAction(new RunAction());
-  run_manager->SetUserAction(new EventAction());
-  run_manager->SetUserAction(new TrackingAction());
-  run_manager->SetUserAction(new SteppingAction());
+  run_manager->SetUserInitialization(new ActionInitialization());
 
-  // Initialize visualization
-  G4VisManager* vismgr = new G4VisExecutive();
-  vismgr->Initialize();
+  // Initialize visualization; batch jobs don't need it
+  G4VisManager* vismgr = 0;
+  if (ui) {
+    vismgr = new G4VisExecutive();
+    vismgr->Initialize();
+  }
 
   // Get the pointer to the User Interface manager
   G4UImanager* uimgr = G4UImanager::GetUIpointer();
@@ -70,8 +204,7 @@ int main(int argc, char** argv)
   if (!ui) {
     // batch mode
     G4String command = "/control/execute ";
-    G4String fileName = argv[1];
-    uimgr->ApplyCommand(command+fileName);
+    uimgr->ApplyCommand(command+macro);
   }
   else {
     // interactive mode
@@ -87,4 +220,5 @@ int main(int argc, char** argv)
 
   delete vismgr;
   delete run_manager;
+  delete importance_sampler;
 }
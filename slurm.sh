@@ -17,7 +17,8 @@ source /n/holystore01/LABS/guenette_lab/Users/amcdonald/Supernova_Qpix/marley/se
 ## Job options                                                                                                                                                                                                                         
 JOBNUMBER=${SLURM_ARRAY_TASK_ID}
 PRESSURE=39
-SEED=`echo "scale = 2; $PRESSURE * $JOBNUMBER" | bc`
+# array task 0 must not get seed 0, which turns per-event seeding off
+SEED=$(( PRESSURE * (JOBNUMBER + 1) ))
 NAME="Nu_e-${SEED}"
 OUT="${NAME}.root"
 
@@ -46,7 +47,7 @@ echo "/supernova/timing/th2_name   nusperbin2d_nue"   >>${INPUT_MACRO}
 
 echo "/Inputs/root_output ${OUTFILE}"                 >>${INPUT_MACRO}
 echo "/run/initialize"                                >>${INPUT_MACRO}
-echo "/random/setSeeds 0 ${SEED}"                     >>${INPUT_MACRO}
+echo "/Inputs/seed ${SEED}"                           >>${INPUT_MACRO}
 
 echo "/Supernova/Event_Cutoff 10 s"                   >>${INPUT_MACRO}
 echo "/run/beamOn 1000"                               >>${INPUT_MACRO}
@@ -0,0 +1,47 @@
+// -----------------------------------------------------------------------------
+//  G4_QPIX | ActionInitialization.cpp
+//
+//  Instantiation of the user actions for the master and worker threads.
+//   * Author: Everybody is an author!
+//   * Creation date: 16 Oct 2026
+// -----------------------------------------------------------------------------
+
+#include "ActionInitialization.h"
+
+// Q-Pix includes
+#include "PrimaryGeneration.h"
+#include "RunAction.h"
+#include "EventAction.h"
+#include "StackingAction.h"
+#include "TrackingAction.h"
+#include "SteppingAction.h"
+
+
+ActionInitialization::ActionInitialization(): G4VUserActionInitialization()
+{
+}
+
+
+ActionInitialization::~ActionInitialization()
+{
+}
+
+
+void ActionInitialization::BuildForMaster() const
+{
+    // the master thread only needs a run action; it does not track events
+    SetUserAction(new RunAction());
+}
+
+
+void ActionInitialization::Build() const
+{
+    // every worker gets its own set of user actions, and through them its own
+    // thread-local AnalysisManager and MCTruthManager
+    SetUserAction(new PrimaryGeneration());
+    SetUserAction(new RunAction());
+    SetUserAction(new EventAction());
+    SetUserAction(new StackingAction());
+    SetUserAction(new TrackingAction());
+    SetUserAction(new SteppingAction());
+}
@@ -0,0 +1,26 @@
+// -----------------------------------------------------------------------------
+//  G4_QPIX | ActionInitialization.h
+//
+//  Instantiation of the user actions for the master and worker threads.
+//   * Author: Everybody is an author!
+//   * Creation date: 16 Oct 2026
+// -----------------------------------------------------------------------------
+
+#ifndef ACTION_INITIALIZATION_H
+#define ACTION_INITIALIZATION_H
+
+#include <G4VUserActionInitialization.hh>
+
+
+class ActionInitialization: public G4VUserActionInitialization
+{
+    public:
+
+        ActionInitialization();
+        virtual ~ActionInitialization();
+
+        virtual void BuildForMaster() const;
+        virtual void Build() const;
+};
+
+#endif
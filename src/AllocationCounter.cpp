@@ -0,0 +1,138 @@
+// -----------------------------------------------------------------------------
+//  AllocationCounter.cpp
+//
+//  Class definition of the allocation counter
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#include "AllocationCounter.h"
+
+#ifdef WITH_ALLOCATION_COUNTER
+
+// GEANT4 includes
+#include "G4ios.hh"
+#include "G4Threading.hh"
+
+// C++ includes
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+    // plain thread-local data, usable from inside operator new
+    struct Counts
+    {
+        long allocations[AllocationCounter::kNumberPhases];
+        long bytes[AllocationCounter::kNumberPhases];
+    };
+
+    thread_local int    phase_ = AllocationCounter::kIdle;
+    thread_local Counts event_;
+
+    // accumulated over the run
+    thread_local Counts run_;
+    thread_local long   number_events_;
+
+    // events after the first one that allocated in a given phase
+    thread_local long   allocating_events_[AllocationCounter::kNumberPhases];
+
+    char const * const phase_names_[AllocationCounter::kNumberPhases] =
+        { "idle", "generation", "tracking", "truth", "fill" };
+
+    inline void Count(std::size_t const size)
+    {
+        event_.allocations[phase_] += 1;
+        event_.bytes[phase_] += size;
+    }
+
+    void * Allocate(std::size_t const size)
+    {
+        Count(size);
+        void * p = std::malloc(size ? size : 1);
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+
+    void * Allocate(std::size_t const size, std::align_val_t const alignment)
+    {
+        Count(size);
+        std::size_t const align = static_cast< std::size_t >(alignment);
+        // aligned_alloc wants a size that is a multiple of the alignment
+        void * p = std::aligned_alloc(align, (size + align - 1) / align * align);
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+// replacements of the global allocation functions
+//-----------------------------------------------------------------------------
+void * operator new(std::size_t size)   { return Allocate(size); }
+void * operator new[](std::size_t size) { return Allocate(size); }
+void * operator new(std::size_t size, std::align_val_t alignment)   { return Allocate(size, alignment); }
+void * operator new[](std::size_t size, std::align_val_t alignment) { return Allocate(size, alignment); }
+
+void operator delete(void * p) noexcept   { std::free(p); }
+void operator delete[](void * p) noexcept { std::free(p); }
+void operator delete(void * p, std::size_t) noexcept   { std::free(p); }
+void operator delete[](void * p, std::size_t) noexcept { std::free(p); }
+void operator delete(void * p, std::align_val_t) noexcept   { std::free(p); }
+void operator delete[](void * p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void * p, std::size_t, std::align_val_t) noexcept   { std::free(p); }
+void operator delete[](void * p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+//-----------------------------------------------------------------------------
+void AllocationCounter::SetPhase(Phase const phase)
+{
+    phase_ = phase;
+}
+
+//-----------------------------------------------------------------------------
+void AllocationCounter::EndEvent()
+{
+    for (int phase = 0; phase < kNumberPhases; ++phase)
+    {
+        if (number_events_ > 0 && event_.allocations[phase] > 0) allocating_events_[phase] += 1;
+
+        run_.allocations[phase] += event_.allocations[phase];
+        run_.bytes[phase] += event_.bytes[phase];
+
+        event_.allocations[phase] = 0;
+        event_.bytes[phase] = 0;
+    }
+
+    number_events_ += 1;
+    phase_ = kIdle;
+}
+
+//-----------------------------------------------------------------------------
+void AllocationCounter::Reset()
+{
+    run_ = Counts();
+    event_ = Counts();
+    number_events_ = 0;
+    for (auto & count : allocating_events_) count = 0;
+    phase_ = kIdle;
+}
+
+//-----------------------------------------------------------------------------
+void AllocationCounter::Report()
+{
+    if (number_events_ < 1) return;
+
+    G4cout << "AllocationCounter: thread " << G4Threading::G4GetThreadId()
+           << ", " << number_events_ << " events" << G4endl;
+
+    for (int phase = kGeneration; phase < kNumberPhases; ++phase)
+    {
+        G4cout << "  " << phase_names_[phase] << ": "
+               << double(run_.allocations[phase]) / number_events_ << " allocations/event, "
+               << double(run_.bytes[phase]) / number_events_ << " bytes/event, "
+               << allocating_events_[phase] << " events allocating after the first"
+               << G4endl;
+    }
+}
+
+#endif
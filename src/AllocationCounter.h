@@ -0,0 +1,39 @@
+// -----------------------------------------------------------------------------
+//  AllocationCounter.h
+//
+//  Class definition of the allocation counter
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#ifndef AllocationCounter_h
+#define AllocationCounter_h 1
+
+// Counts the heap allocations made by each thread, split by the phase of the
+// event they were made in. The global operator new is only replaced when
+// the code is built with -DWITH_ALLOCATION_COUNTER=ON; otherwise all the
+// calls below compile to nothing.
+class AllocationCounter {
+
+    public:
+
+        enum Phase { kIdle, kGeneration, kTracking, kTruth, kFill, kNumberPhases };
+
+#ifdef WITH_ALLOCATION_COUNTER
+        static void SetPhase(Phase const);
+
+        // close the current event and go back to the idle phase
+        static void EndEvent();
+
+        static void Reset();
+        static void Report();
+#else
+        static inline void SetPhase(Phase const) {}
+        static inline void EndEvent() {}
+        static inline void Reset() {}
+        static inline void Report() {}
+#endif
+
+};
+
+#endif
@@ -8,10 +8,52 @@
 
 #include "AnalysisManager.h"
 
-AnalysisManager * AnalysisManager::instance_ = 0;
+// Q-Pix includes
+#include "ProcessRegistry.h"
+
+// C++ includes
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+    // TFile that keeps track of the time spent writing to disk
+    class TimedFile : public TFile
+    {
+        public:
+
+            TimedFile(char const * path, char const * option, char const * title)
+                : TFile(path, option, title)
+            {}
+
+            inline double WriteTime() const { return write_time_; }
+
+        protected:
+
+            Int_t SysWrite(Int_t fd, const void * buffer, Int_t length) override
+            {
+                auto const start = std::chrono::steady_clock::now();
+                Int_t const status = TFile::SysWrite(fd, buffer, length);
+                write_time_ += std::chrono::duration< double >(
+                    std::chrono::steady_clock::now() - start).count();
+                return status;
+            }
+
+        private:
+
+            double write_time_ = 0;
+    };
+
+}
+
+G4ThreadLocal AnalysisManager * AnalysisManager::instance_ = 0;
 
 //-----------------------------------------------------------------------------
 AnalysisManager::AnalysisManager()
+  : tfile_(0), metadata_(0), event_tree_(0),
+    voxel_pitch_(0), voxel_time_bin_(0), energy_threshold_(0), run_(-1),
+    record_(&output_), stop_writer_(false),
+    blocked_time_(0), fill_time_(0), number_events_written_(0)
 {
 #ifdef G4ANALYSIS_USE
 #endif
@@ -22,6 +64,7 @@ AnalysisManager::~AnalysisManager()
 {
 #ifdef G4ANALYSIS_USE
 #endif
+    this->StopWriter();
 }
 
 //-----------------------------------------------------------------------------
@@ -32,10 +75,10 @@ AnalysisManager * AnalysisManager::Instance()
 }
 
 //-----------------------------------------------------------------------------
-void AnalysisManager::Book(std::string const file_path)
+void AnalysisManager::Book(std::string const file_path, int const queue_depth, bool const worker)
 {
     // ROOT output file
-    tfile_ = new TFile(file_path.data(), "recreate", "qpix");
+    tfile_ = new TimedFile(file_path.data(), "recreate", "qpix");
 
     // metadata tree
     metadata_ = new TTree("metadata", "metadata");
@@ -43,124 +86,374 @@ void AnalysisManager::Book(std::string const file_path)
     metadata_->Branch("detector_length_x", &detector_length_x_, "detector_length_x/D");
     metadata_->Branch("detector_length_y", &detector_length_y_, "detector_length_y/D");
     metadata_->Branch("detector_length_z", &detector_length_z_, "detector_length_z/D");
+    metadata_->Branch("process_names",     &process_names_);
+    metadata_->Branch("voxel_pitch",       &voxel_pitch_,       "voxel_pitch/D");
+    metadata_->Branch("voxel_time_bin",    &voxel_time_bin_,    "voxel_time_bin/D");
+    metadata_->Branch("energy_threshold",  &energy_threshold_,  "energy_threshold/D");
+
+    voxel_pitch_ = 0;
+    voxel_time_bin_ = 0;
+    energy_threshold_ = 0;
 
     // event tree
     event_tree_ = new TTree("event_tree", "event tree");
+    output_.Branch(event_tree_);
+
+    if (worker) event_tree_->Branch("sub_event", &output_.sub_event_, "sub_event/I");
+
+    blocked_time_ = 0;
+    fill_time_ = 0;
+    number_events_written_ = 0;
+
+    record_ = &output_;
+
+    if (queue_depth < 1) return;
+
+    // the writer fills the tree while the tracking thread keeps running;
+    // main() has enabled ROOT's thread safety for it
+
+    // one record is being filled by the tracking thread while up to
+    // queue_depth records wait for the writer
+    records_.clear();
+    records_.resize(queue_depth + 1);
 
-    event_tree_->Branch("run",   &run_,   "run/I");
-    event_tree_->Branch("event", &event_, "event/I");
-
-    
-    event_tree_->Branch("number_particles", &number_particles_, "number_particles/I");
-    event_tree_->Branch("number_hits",      &number_hits_,      "number_hits/I");
-
-    event_tree_->Branch("energy_deposit",   &energy_deposit_,   "energy_deposit/D");
-
-    event_tree_->Branch("particle_track_id",        &particle_track_id_);
-    event_tree_->Branch("particle_parent_track_id", &particle_parent_track_id_);
-    event_tree_->Branch("particle_pdg_code",        &particle_pdg_code_);
-    event_tree_->Branch("particle_mass",            &particle_mass_);
-    event_tree_->Branch("particle_charge",          &particle_charge_);
-    event_tree_->Branch("particle_process_key",     &particle_process_key_);
-    event_tree_->Branch("particle_total_occupancy", &particle_total_occupancy_);
-    event_tree_->Branch("particle_initial_x",       &particle_initial_x_);
-    event_tree_->Branch("particle_initial_y",       &particle_initial_y_);
-    event_tree_->Branch("particle_initial_z",       &particle_initial_z_);
-    event_tree_->Branch("particle_initial_t",       &particle_initial_t_);
-    event_tree_->Branch("particle_initial_px",      &particle_initial_px_);
-    event_tree_->Branch("particle_initial_py",      &particle_initial_py_);
-    event_tree_->Branch("particle_initial_pz",      &particle_initial_pz_);
-    event_tree_->Branch("particle_initial_energy",  &particle_initial_energy_);
-
-    event_tree_->Branch("particle_number_daughters",  &particle_number_daughters_);
-    event_tree_->Branch("particle_daughter_track_id", &particle_daughter_track_ids_);
-
-    event_tree_->Branch("hit_track_id",       &hit_track_id_);
-    event_tree_->Branch("hit_start_x",        &hit_start_x_);
-    event_tree_->Branch("hit_start_y",        &hit_start_y_);
-    event_tree_->Branch("hit_start_z",        &hit_start_z_);
-    event_tree_->Branch("hit_start_t",        &hit_start_t_);
-    event_tree_->Branch("hit_end_x",          &hit_end_x_);
-    event_tree_->Branch("hit_end_y",          &hit_end_y_);
-    event_tree_->Branch("hit_end_z",          &hit_end_z_);
-    event_tree_->Branch("hit_end_t",          &hit_end_t_);
-    event_tree_->Branch("hit_energy_deposit", &hit_energy_deposit_);
-    event_tree_->Branch("hit_length",         &hit_length_);
-    event_tree_->Branch("hit_process_key",    &hit_process_key_);
+    queue_.clear();
+    free_.clear();
+    for (auto & record : records_) free_.push_back(&record);
+
+    record_ = free_.front();
+    free_.pop_front();
+
+    stop_writer_ = false;
+    writer_ = std::thread(&AnalysisManager::WriterLoop, this);
 }
 
 //-----------------------------------------------------------------------------
 void AnalysisManager::Save()
 {
+    // write out the events still queued
+    this->StopWriter();
+
+    TimedFile const * tfile = static_cast< TimedFile const * >(tfile_);
+    double const fill_write_time = tfile->WriteTime();
+
     // write TTree objects to file and close file
     tfile_->cd();
     metadata_->Write();
     event_tree_->Write();
     tfile_->Close();
+
+    G4cout << "AnalysisManager::Save: wrote " << number_events_written_ << " events"
+           << "\n  tracking thread blocked on writer: " << blocked_time_ << " s"
+           << "\n  serialization and compression:     " << fill_time_ - fill_write_time << " s"
+           << "\n  disk writes:                       " << tfile->WriteTime() << " s"
+           << G4endl;
 }
 
 //-----------------------------------------------------------------------------
 void AnalysisManager::EventReset()
 {
     // reset event variables after filling TTree objects per event
-    event_ = -1;
-    number_particles_ = 0;
-
-    number_hits_ = 0;
-    energy_deposit_ = 0;
-
-    particle_track_id_.clear();
-    particle_parent_track_id_.clear();
-    particle_pdg_code_.clear();
-    particle_mass_.clear();
-    particle_charge_.clear();
-    particle_process_key_.clear();
-    particle_total_occupancy_.clear();
-
-    particle_number_daughters_.clear();
-    particle_daughter_track_ids_.clear();
-
-    particle_initial_x_.clear();
-    particle_initial_y_.clear();
-    particle_initial_z_.clear();
-    particle_initial_t_.clear();
-
-    particle_initial_px_.clear();
-    particle_initial_py_.clear();
-    particle_initial_pz_.clear();
-    particle_initial_energy_.clear();
-
-    hit_track_id_.clear();
-    hit_start_x_.clear();
-    hit_start_y_.clear();
-    hit_start_z_.clear();
-    hit_start_t_.clear();
-    hit_end_x_.clear();
-    hit_end_y_.clear();
-    hit_end_z_.clear();
-    hit_end_t_.clear();
-    hit_energy_deposit_.clear();
-    hit_length_.clear();
-    hit_process_key_.clear();
+    record_->Reset();
+
+    // daughters of pruned parents are never claimed
+    written_daughters_.clear();
+}
+
+//-----------------------------------------------------------------------------
+void AnalysisManager::ChunkReset()
+{
+    // the daughters written so far stay known to their parents in later
+    // chunks of the event
+    record_->Reset();
 }
 
 //-----------------------------------------------------------------------------
 void AnalysisManager::EventFill()
 {
+    record_->run_ = run_;
+
     // fill TTree objects per event
-    event_tree_->Fill();
+    if (record_ == &output_)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        event_tree_->Fill();
+        fill_time_ += std::chrono::duration< double >(
+            std::chrono::steady_clock::now() - start).count();
+        number_events_written_ += 1;
+        return;
+    }
+
+    // hand the record over to the writer and carry on with a free one
+    auto const start = std::chrono::steady_clock::now();
+
+    std::unique_lock< std::mutex > lock(mutex_);
+    queue_.push_back(record_);
+    condition_.notify_all();
+    condition_.wait(lock, [this] { return !free_.empty(); });
+    record_ = free_.front();
+    free_.pop_front();
+    lock.unlock();
+
+    blocked_time_ += std::chrono::duration< double >(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+//-----------------------------------------------------------------------------
+void AnalysisManager::WriterLoop()
+{
+    while (true)
+    {
+        std::unique_lock< std::mutex > lock(mutex_);
+        condition_.wait(lock, [this] { return stop_writer_ || !queue_.empty(); });
+
+        if (queue_.empty()) return;
+
+        EventRecord * record = queue_.front();
+        queue_.pop_front();
+
+        // move the event into the record bound to the branches; the record
+        // goes back to the pool carrying the old, already written, event
+        std::swap(output_, *record);
+        free_.push_back(record);
+        condition_.notify_all();
+        lock.unlock();
+
+        auto const start = std::chrono::steady_clock::now();
+        event_tree_->Fill();
+        fill_time_ += std::chrono::duration< double >(
+            std::chrono::steady_clock::now() - start).count();
+        number_events_written_ += 1;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void AnalysisManager::StopWriter()
+{
+    if (!writer_.joinable()) return;
+
+    {
+        std::lock_guard< std::mutex > lock(mutex_);
+        stop_writer_ = true;
+    }
+    condition_.notify_all();
+    writer_.join();
+
+    record_ = &output_;
+}
+
+//-----------------------------------------------------------------------------
+void AnalysisManager::Merge(std::vector< std::string > const & file_paths)
+{
+    // copy the event trees of the worker files into the booked event tree.
+    // every worker processes its events in increasing event ID order, so a
+    // k-way merge on (event, sub-event) reproduces the ordering of a
+    // sequential run, including the /event/offset numbering. Consecutive
+    // entries with the same event number are sub-events of one readout
+    // window and are reassembled into a single entry.
+    std::vector< TFile * >  files;
+    std::vector< TTree * >  trees;
+    std::vector< Long64_t > entries;
+    std::vector< std::pair< int, int > > next_keys;
+
+    for (auto const & path : file_paths)
+    {
+        TFile * file = TFile::Open(path.data(), "read");
+
+        if (!file || file->IsZombie())
+        {
+            std::string message = "Could not open worker file " + path;
+            G4Exception("AnalysisManager::Merge", "Warning",
+                        JustWarning, message.data());
+            delete file;
+            continue;
+        }
+
+        TTree * tree = static_cast< TTree * >(file->Get("event_tree"));
+
+        if (!tree || tree->GetEntries() < 1)
+        {
+            file->Close();
+            delete file;
+            continue;
+        }
+
+        // carry the voxel mode of the workers over, before the addresses of
+        // the voxel branches are copied
+        TTree * metadata = static_cast< TTree * >(file->Get("metadata"));
+        if (files.empty() && metadata && metadata->GetBranch("voxel_pitch"))
+        {
+            double voxel_pitch = 0;
+            double voxel_time_bin = 0;
+            metadata->SetBranchAddress("voxel_pitch", &voxel_pitch);
+            metadata->SetBranchAddress("voxel_time_bin", &voxel_time_bin);
+            metadata->GetEntry(0);
+            metadata->ResetBranchAddresses();
+            this->SetVoxelGrid(voxel_pitch, voxel_time_bin);
+        }
+
+        // and the energy threshold, which the workers only applied to whole
+        // events
+        if (files.empty() && metadata && metadata->GetBranch("energy_threshold"))
+        {
+            double energy_threshold = 0;
+            metadata->SetBranchAddress("energy_threshold", &energy_threshold);
+            metadata->GetEntry(0);
+            metadata->ResetBranchAddresses();
+            this->SetEnergyThreshold(energy_threshold);
+        }
+
+        if (files.empty() && tree->GetBranch("chunk")) this->EnableChunks();
+
+        // read the worker tree straight into the variables of our event tree
+        event_tree_->CopyAddresses(tree);
+        tree->SetBranchAddress("sub_event", &output_.sub_event_);
+
+        files.push_back(file);
+        trees.push_back(tree);
+        entries.push_back(0);
+        next_keys.emplace_back(0, 0);
+    }
+
+    // peek at the event number of the next entry of a worker tree
+    auto peek = [&] (size_t const idx)
+    {
+        trees[idx]->GetBranch("event")->GetEntry(entries[idx]);
+        trees[idx]->GetBranch("sub_event")->GetEntry(entries[idx]);
+        next_keys[idx] = { output_.event_, output_.sub_event_ };
+    };
+
+    for (size_t idx = 0; idx < trees.size(); ++idx) peek(idx);
+
+    // event being reassembled from its sub-events; it is only written if
+    // its energy deposit, summed over the sub-events, passes the threshold
+    EventRecord merged;
+    bool pending = false;
+
+    // truth written in chunks is copied chunk by chunk, since reassembling
+    // it would defeat its memory bound, and without the energy threshold;
+    // the chunks of an event are numbered
+    // in order, and the track IDs of each sub-event are moved past those of
+    // the sub-events before it
+    bool const chunks = event_tree_->GetBranch("chunk");
+    int chunk_event = -1;
+    int chunk_sub_event = -1;
+    int chunk_index = 0;
+    int track_id_offset = 0;
+    int max_track_id = 0;
+
+    while (true)
+    {
+        // pick the worker tree whose next entry has the lowest event number
+        int next = -1;
+
+        for (size_t idx = 0; idx < trees.size(); ++idx)
+        {
+            if (entries[idx] >= trees[idx]->GetEntries()) continue;
+            if (next < 0 || next_keys[idx] < next_keys[next]) next = idx;
+        }
+
+        if (next < 0) break;
+
+        trees[next]->GetEntry(entries[next]);
+
+        if (chunks)
+        {
+            if (output_.event_ != chunk_event)
+            {
+                chunk_event = output_.event_;
+                chunk_sub_event = output_.sub_event_;
+                chunk_index = 0;
+                track_id_offset = 0;
+                max_track_id = 0;
+            }
+            else if (output_.sub_event_ != chunk_sub_event)
+            {
+                chunk_sub_event = output_.sub_event_;
+                track_id_offset = max_track_id;
+            }
+
+            output_.ShiftTrackIDs(track_id_offset);
+            for (auto const track_id : output_.particle_track_id_) max_track_id = std::max(max_track_id, track_id);
+            for (auto const track_id : output_.hits_.track_id_) max_track_id = std::max(max_track_id, track_id);
+
+            output_.chunk_ = chunk_index++;
+            event_tree_->Fill();
+        }
+        else if (pending && output_.event_ == merged.event_)
+        {
+            merged.Append(output_, voxel_time_bin_);
+        }
+        else
+        {
+            // write out the previous event, then start from this one
+            if (pending && merged.energy_deposit_ >= energy_threshold_)
+            {
+                std::swap(output_, merged);
+                event_tree_->Fill();
+                std::swap(output_, merged);
+            }
+            std::swap(output_, merged);
+            pending = true;
+        }
+
+        entries[next] += 1;
+
+        if (entries[next] < trees[next]->GetEntries()) peek(next);
+    }
+
+    if (pending && merged.energy_deposit_ >= energy_threshold_)
+    {
+        std::swap(output_, merged);
+        event_tree_->Fill();
+    }
+
+    for (size_t idx = 0; idx < files.size(); ++idx)
+    {
+        event_tree_->CopyAddresses(trees[idx], true);
+        trees[idx]->ResetBranchAddress(trees[idx]->GetBranch("sub_event"));
+        files[idx]->Close();
+        delete files[idx];
+    }
+
+    this->EventReset();
+}
+
+//-----------------------------------------------------------------------------
+void AnalysisManager::SetEnergyThreshold(double const energy)
+{
+    energy_threshold_ = energy;
 }
 
 //-----------------------------------------------------------------------------
 void AnalysisManager::SetRun(int const value)
 {
     run_ = value;
+    output_.run_ = value;
 }
 
 //-----------------------------------------------------------------------------
 void AnalysisManager::SetEvent(int const value)
 {
-    event_ = value;
+    record_->event_ = value;
+}
+
+//-----------------------------------------------------------------------------
+void AnalysisManager::SetSubEvent(int const value)
+{
+    record_->sub_event_ = value;
+}
+
+//-----------------------------------------------------------------------------
+void AnalysisManager::SetChunk(int const value)
+{
+    record_->chunk_ = value;
+}
+
+//-----------------------------------------------------------------------------
+void AnalysisManager::EnableChunks()
+{
+    if (!event_tree_->GetBranch("chunk")) event_tree_->Branch("chunk", &output_.chunk_, "chunk/I");
 }
 
 //-----------------------------------------------------------------------------
@@ -171,6 +464,7 @@ void AnalysisManager::FillMetadata(double const & detector_length_x,
     detector_length_x_ = detector_length_x;
     detector_length_y_ = detector_length_y;
     detector_length_z_ = detector_length_z;
+    process_names_ = ProcessRegistry::Instance()->Names();
     metadata_->Fill();
 }
 
@@ -178,79 +472,89 @@ void AnalysisManager::FillMetadata(double const & detector_length_x,
 
 void AnalysisManager::AddMCParticle(MCParticle const * particle)
 {
-    particle_track_id_.push_back(particle->TrackID());
-    particle_parent_track_id_.push_back(particle->ParentTrackID());
-    particle_pdg_code_.push_back(particle->PDGCode());
-    particle_mass_.push_back(particle->Mass());
-    particle_charge_.push_back(particle->Charge());
-    particle_process_key_.push_back(this->ProcessToKey(particle->Process()));
-    particle_total_occupancy_.push_back(particle->TotalOccupancy());
-
-    particle_initial_x_.push_back(particle->InitialPosition().X());
-    particle_initial_y_.push_back(particle->InitialPosition().Y());
-    particle_initial_z_.push_back(particle->InitialPosition().Z());
-    particle_initial_t_.push_back(particle->InitialPosition().T());
-
-    particle_initial_px_.push_back(particle->InitialMomentum().X());
-    particle_initial_py_.push_back(particle->InitialMomentum().Y());
-    particle_initial_pz_.push_back(particle->InitialMomentum().Z());
-    particle_initial_energy_.push_back(particle->InitialMomentum().E());
+    record_->particle_track_id_.push_back(particle->TrackID());
+    record_->particle_parent_track_id_.push_back(particle->ParentTrackID());
+    record_->particle_pdg_code_.push_back(particle->PDGCode());
+    record_->particle_mass_.push_back(particle->Mass());
+    record_->particle_charge_.push_back(particle->Charge());
+    record_->particle_process_key_.push_back(particle->ProcessKey());
+    record_->particle_total_occupancy_.push_back(particle->TotalOccupancy());
+    record_->particle_weight_.push_back(particle->Weight());
+
+    record_->particle_initial_x_.push_back(particle->InitialX());
+    record_->particle_initial_y_.push_back(particle->InitialY());
+    record_->particle_initial_z_.push_back(particle->InitialZ());
+    record_->particle_initial_t_.push_back(particle->InitialT());
+
+    record_->particle_initial_px_.push_back(particle->InitialPx());
+    record_->particle_initial_py_.push_back(particle->InitialPy());
+    record_->particle_initial_pz_.push_back(particle->InitialPz());
+    record_->particle_initial_energy_.push_back(particle->InitialEnergy());
+
+    record_->particle_number_daughters_.push_back(0);
+    record_->particle_daughter_track_ids_.emplace_back();
+
+    // daughters written in an earlier chunk of the event
+    auto const written = written_daughters_.find(particle->TrackID());
+    if (written != written_daughters_.end())
+    {
+        record_->particle_number_daughters_.back() = written->second.size();
+        record_->particle_daughter_track_ids_.back() = written->second;
+        written_daughters_.erase(written);
+    }
 
-    particle_number_daughters_.push_back(particle->NumberDaughters());
-    particle_daughter_track_ids_.push_back(particle->Daughters());
+    // a parent is created, and gets its track ID, before its daughters, and
+    // particles are added in ascending track ID order, so the parent is
+    // already in the record. Only daughters that are written are counted,
+    // which keeps the daughter lists consistent when the truth is pruned.
+    auto const & track_ids = record_->particle_track_id_;
+    auto const parent = std::lower_bound(track_ids.begin(), track_ids.end() - 1, particle->ParentTrackID());
+    if (parent != track_ids.end() - 1 && *parent == particle->ParentTrackID())
+    {
+        record_->particle_number_daughters_[parent - track_ids.begin()] += 1;
+        record_->particle_daughter_track_ids_[parent - track_ids.begin()].push_back(particle->TrackID());
+    }
+    else if (particle->ParentTrackID() > 0)
+    {
+        // the parent is still open and goes into a later chunk
+        written_daughters_[particle->ParentTrackID()].push_back(particle->TrackID());
+    }
 
-    number_particles_ += 1;
+    record_->number_particles_ += 1;
+}
 
-    std::vector< TrajectoryHit > const hits = particle->Hits();
+//-----------------------------------------------------------------------------
+void AnalysisManager::AddHits(HitBuffer & hits)
+{
+    // take the hit columns over; the buffer gets the old, cleared, columns
+    // of the record back and keeps their capacity
+    std::swap(record_->hits_, hits);
 
-    for (auto const & hit : hits)
-    {
-        energy_deposit_ += hit.Energy();
+    record_->number_hits_ = record_->hits_.Size();
 
-        hit_track_id_.push_back(hit.TrackID());
+    record_->energy_deposit_ = 0;
+    for (auto const energy : record_->hits_.energy_deposit_) record_->energy_deposit_ += energy;
+}
 
-        hit_start_x_.push_back(hit.StartPoint().X());
-        hit_start_y_.push_back(hit.StartPoint().Y());
-        hit_start_z_.push_back(hit.StartPoint().Z());
-        hit_start_t_.push_back(hit.StartTime());
+//-----------------------------------------------------------------------------
+void AnalysisManager::AddVoxels(VoxelBuffer & voxels)
+{
+    voxels.Finish();
 
-        hit_end_x_.push_back(hit.EndPoint().X());
-        hit_end_y_.push_back(hit.EndPoint().Y());
-        hit_end_z_.push_back(hit.EndPoint().Z());
-        hit_end_t_.push_back(hit.EndTime());
+    std::swap(record_->voxels_, voxels);
 
-        hit_length_.push_back(hit.Length());
-        hit_energy_deposit_.push_back(hit.Energy());
+    record_->number_voxels_ = record_->voxels_.Size();
 
-        hit_process_key_.push_back(this->ProcessToKey(hit.Process()));
-        number_hits_ += 1;
-    }
+    for (auto const energy : record_->voxels_.energy_deposit_) record_->energy_deposit_ += energy;
 }
 
 //-----------------------------------------------------------------------------
-int AnalysisManager::ProcessToKey(std::string const & process)
+void AnalysisManager::SetVoxelGrid(double const pitch, double const time_bin)
 {
-    int key = -1;
-
-    if      (process.compare("primary")              == 0) key =  0;
-    else if (process.compare("eIoni")                == 0) key =  1;
-    else if (process.compare("msc")                  == 0) key =  2;
-    else if (process.compare("compt")                == 0) key =  3;
-    else if (process.compare("phot")                 == 0) key =  4;
-    else if (process.compare("eBrem")                == 0) key =  5;
-    else if (process.compare("ionIoni")              == 0) key =  6;
-    else if (process.compare("hIoni")                == 0) key =  7;
-    else if (process.compare("RadioactiveDecayBase") == 0) key =  8;
-    else if (process.compare("CoulombScat")          == 0) key =  9;
-    else if (process.compare("Rayl")                 == 0) key = 10;
-    else if (process.compare("Transportation")       == 0) key = 11;
-    else if (process.compare("annihil")              == 0) key = 12;
-    else if (process.compare("conv")                 == 0) key = 13;
-    else if (process.compare("hadElastic")           == 0) key = 14;
-    else if (process.compare("nCapture")             == 0) key = 15;
-    else if (process.compare("neutronInelastic")     == 0) key = 16;
-    else if (process.compare("photonNuclear")        == 0) key = 17;
-
-    return key;
-}
+    voxel_pitch_ = pitch;
+    voxel_time_bin_ = time_bin;
 
+    // the branches are bound to the output record; the writer moves the
+    // other records into it, so they need no branches of their own
+    if (pitch > 0. && !event_tree_->GetBranch("voxel_key")) output_.BranchVoxels(event_tree_);
+}
@@ -10,8 +10,11 @@
 #define AnalysisManager_h 1
 
 // Q-Pix includes
+#include "EventRecord.h"
 #include "GeneratorParticle.h"
+#include "HitBuffer.h"
 #include "MCParticle.h"
+#include "VoxelBuffer.h"
 
 // GEANT4 includes
 #include "globals.hh"
@@ -23,8 +26,13 @@
 #include "TBranch.h"
 
 // C++ includes
+#include <condition_variable>
+#include <deque>
 #include <map>
-#include <set>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 class AnalysisManager {
 
@@ -33,30 +41,56 @@ class AnalysisManager {
         AnalysisManager();
         ~AnalysisManager();
 
-        void Book(std::string const);
+        // the second argument is the depth of the queue of events waiting
+        // for the background writer; 0 fills the event tree synchronously.
+        // Per-worker files that are merged at the end of the run (third
+        // argument) also carry the sub-event index.
+        void Book(std::string const, int const = 0, bool const = false);
         void Save();
         void EventFill();
         void EventReset();
+        void ChunkReset();
+
+        void Merge(std::vector< std::string > const &);
 
         void SetRun(int const);
         void SetEvent(int const);
+        void SetSubEvent(int const);
+        void SetChunk(int const);
+
+        // add the chunk index to the event tree, for truth written in chunks
+        void EnableChunks();
 
         void FillMetadata(double const &, double const &, double const &);
 
+        // voxel pitch (cm) and time bin (ns) of the voxel output mode, saved
+        // as metadata; a pitch above 0 also books the voxel branches
+        void SetVoxelGrid(double const, double const);
+
+        // energy threshold of the events (MeV), saved as metadata; the
+        // merge applies it to the readout windows it reassembles from
+        // sub-events, which the workers can't cut on
+        void SetEnergyThreshold(double const);
+
         void AddMCParticle(MCParticle const *);
 
-        int ProcessToKey(std::string const &);
+        // move the hits of the event into the record; the buffer is left
+        // empty
+        void AddHits(HitBuffer &);
 
-        inline void AddProcess(std::string const & process) { process_names_.insert(process); }
-        inline std::set< std::string > GetProcessNames() const { return process_names_; }
+        // move the voxels of the event into the record; the buffer is left
+        // empty
+        void AddVoxels(VoxelBuffer &);
+
+        // energy deposited by the hits and voxels of the current event
+        inline double EnergyDeposit() const { return record_->energy_deposit_; }
 
         static AnalysisManager* Instance();
 
     private:
 
-        static AnalysisManager * instance_;
-
-        std::set< std::string > process_names_;
+        // one instance per worker thread
+        static G4ThreadLocal AnalysisManager * instance_;
 
         // ROOT objects
         TFile * tfile_;
@@ -68,49 +102,48 @@ class AnalysisManager {
         double detector_length_y_;
         double detector_length_z_;
 
-        // variables that will go into the event trees
+        // process names indexed by process key
+        std::vector< std::string > process_names_;
+
+        double voxel_pitch_;
+        double voxel_time_bin_;
+
+        double energy_threshold_;
+
         int run_;
-        int event_;
-
-        int number_particles_;
-        int number_hits_;
-
-        double energy_deposit_;
-
-        std::vector< int >    particle_track_id_;
-        std::vector< int >    particle_parent_track_id_;
-        std::vector< int >    particle_pdg_code_;
-        std::vector< double > particle_mass_;
-        std::vector< double > particle_charge_;
-        std::vector< int >    particle_process_key_;
-        std::vector< int >    particle_total_occupancy_;
-
-        std::vector< int >                particle_number_daughters_;
-        std::vector< std::vector< int > > particle_daughter_track_ids_;
-
-        std::vector< double > particle_initial_x_;
-        std::vector< double > particle_initial_y_;
-        std::vector< double > particle_initial_z_;
-        std::vector< double > particle_initial_t_;
-
-        std::vector< double > particle_initial_px_;
-        std::vector< double > particle_initial_py_;
-        std::vector< double > particle_initial_pz_;
-        std::vector< double > particle_initial_energy_;
-
-        std::vector< int >    hit_track_id_;
-        std::vector< double > hit_start_x_;
-        std::vector< double > hit_start_y_;
-        std::vector< double > hit_start_z_;
-        std::vector< double > hit_start_t_;
-        std::vector< double > hit_end_x_;
-        std::vector< double > hit_end_y_;
-        std::vector< double > hit_end_z_;
-        std::vector< double > hit_end_t_;
-        std::vector< double > hit_length_;
-        std::vector< double > hit_energy_deposit_;
-        std::vector< int >    hit_process_key_;
 
+        // record the event tree branches are bound to
+        EventRecord output_;
+
+        // record being filled for the current event; this is the output
+        // record itself when events are written synchronously
+        EventRecord * record_;
+
+        // track IDs of daughters written before their parent, by parent
+        // track ID; only used when the truth is written in chunks
+        std::map< int, std::vector< int > > written_daughters_;
+
+        //---------------------------------------------------------------------
+        // background writer
+        //---------------------------------------------------------------------
+
+        void WriterLoop();
+        void StopWriter();
+
+        // records handed to the writer, and records free to be filled
+        std::vector< EventRecord > records_;
+        std::deque< EventRecord * > queue_;
+        std::deque< EventRecord * > free_;
+
+        std::thread             writer_;
+        std::mutex              mutex_;
+        std::condition_variable condition_;
+        bool                    stop_writer_;
+
+        // accounting, in seconds
+        double blocked_time_;  // tracking thread waiting for a free record
+        double fill_time_;     // writer in TTree::Fill
+        int    number_events_written_;
 };
 
 #endif
@@ -9,6 +9,9 @@
 #include "DetectorConstruction.h"
 #include "TrackingSD.h"
 #include "DetectorMessenger.hh"
+#include "FastElectronModel.h"
+#include "ForceCollisionOperator.h"
+#include "StartupTiming.h"
 
 #include "G4Tubs.hh"
 #include "G4Box.hh"
@@ -23,13 +26,22 @@
 #include "G4PhysicalVolumeStore.hh"
 #include "G4SolidStore.hh"
 #include "G4RunManager.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4UserLimits.hh"
 
 #include "G4SystemOfUnits.hh"
 #include "G4PhysicalConstants.hh"
 #include "G4UnitsTable.hh"
 
+#include <algorithm>
 
-DetectorConstruction::DetectorConstruction(): G4VUserDetectorConstruction(), fTargetMater(0), fLogicTarget(0)
+
+DetectorConstruction::DetectorConstruction(): G4VUserDetectorConstruction(), fTargetMater(0), fLogicTarget(0),
+  fShieldCut(0), fVacuumCut(0), fWallCut(0), fPassiveMinEkin(0), fPassiveMaxTime(0), fPassiveLimits(0),
+  fFastElectrons(false)
 {
   fTargetLength      = 25.4*cm;
   fTargetRadius      = 20*cm;
@@ -82,6 +94,7 @@ void DetectorConstruction::DefineMaterials()
   G4Element* Fe = new G4Element("Iron", "Fe", 26, 55.845*g/mole);
 
 
+  G4NistManager* man = G4NistManager::Instance();
   fTargetMater = man->FindOrBuildMaterial("G4_lAr");
   fShieldMater = man->FindOrBuildMaterial("G4_STAINLESS-STEEL");
   fVacuumMater = man->FindOrBuildMaterial("G4_Galactic");
@@ -92,14 +105,17 @@ void DetectorConstruction::DefineMaterials()
 
 
 DetectorConstruction::~DetectorConstruction()
-{delete fDetectorMessenger;}
+{delete fDetectorMessenger; delete fPassiveLimits;}
 
 G4VPhysicalVolume* DetectorConstruction::Construct()
 {
+  StartupTiming::Record(StartupTiming::kGeometryStart);
+
   // WORLD /////////////////////////////////////////////////
 
-  fWorldLength = fTargetLength + (5.0*cm);
-  fWorldRadius = fTargetRadius + (1.0*cm);
+  // the world holds the target and the shield, vacuum and wall shells
+  fWorldLength = std::max({fTargetLength, fShieldLength, fVacuumLength, fWallLength}) + (5.0*cm);
+  fWorldRadius = fTargetRadius + fShieldThickness + fVacuumThickness + fWallThickness + (1.0*cm);
 
   G4Tubs*
   sWorld = new G4Tubs("World",                                 //name
@@ -163,7 +179,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
 
   G4Tubs* 
   sVacuum = new G4Tubs("Vacuum",  
-                fTargetRadius+fVacuumThickness, fTargetRadius+fShieldThickness+fVacuumThickness, 0.5*fVacuumLength, 0.,twopi);
+                fTargetRadius+fShieldThickness, fTargetRadius+fShieldThickness+fVacuumThickness, 0.5*fVacuumLength, 0.,twopi);
 
 
   fLogicVacuum = new G4LogicalVolume(sVacuum,       //shape
@@ -199,8 +215,30 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
                            0);                          //copy number
 
 
+  // REGIONS /////////////////////////////////////////////
+
+  // the target keeps the default cuts; its region is the envelope of the
+  // fast simulation of low-energy electrons
+  SetupRegion("Target", fLogicTarget, 0.);
+
+  // the passive volumes don't need the precision of the target: they get
+  // their own production cuts, and tracks in them can be killed below an
+  // energy or after a time through G4UserSpecialCuts
+  SetupRegion("Shield", fLogicShield, fShieldCut);
+  SetupRegion("Vacuum", fLogicVacuum, fVacuumCut);
+  SetupRegion("Wall",   fLogicWall,   fWallCut);
+
+  if (!fPassiveLimits) fPassiveLimits = new G4UserLimits();
+  fPassiveLimits->SetUserMaxTime(fPassiveMaxTime > 0. ? fPassiveMaxTime : DBL_MAX);
+  fPassiveLimits->SetUserMinEkine(fPassiveMinEkin);
+
+  fLogicShield->SetUserLimits(fPassiveLimits);
+  fLogicVacuum->SetUserLimits(fPassiveLimits);
+  fLogicWall->SetUserLimits(fPassiveLimits);
+
   PrintParameters();
 
+  StartupTiming::Record(StartupTiming::kGeometryEnd);
 
   return fPhysiWorld;
 }
@@ -209,17 +247,77 @@ void DetectorConstruction::ConstructSDandField()
 {
   // SENSITIVE DETECTOR ////////////////////////////////////
 
-  TrackingSD* tracking_sd = new TrackingSD("/G4QPIX/TRACKING", "TrackingHitsCollection");
-  G4SDManager::GetSDMpointer()->AddNewDetector(tracking_sd);
+  // a rebuilt geometry runs this again; the sensitive detector of the
+  // thread, which holds the /hits/ settings, is kept for the new volumes
+  G4SDManager* sd_manager = G4SDManager::GetSDMpointer();
+  TrackingSD* tracking_sd =
+    static_cast<TrackingSD*>(sd_manager->FindSensitiveDetector("/G4QPIX/TRACKING", false));
+  if (!tracking_sd) {
+    tracking_sd = new TrackingSD("/G4QPIX/TRACKING", "TrackingHitsCollection");
+    sd_manager->AddNewDetector(tracking_sd);
+  }
 
   G4LogicalVolume* detector_logic_vol =
     G4LogicalVolumeStore::GetInstance()->GetVolume("Target");
 
   SetSensitiveDetector(fLogicTarget, tracking_sd);
 
+  // BIASING ///////////////////////////////////////////////
+
+  // every thread has its own biasing operator; a logical volume takes only
+  // one, which hands each particle type to its own forced collision
+  if (!fForcedCollisionParticles.empty()) {
+    ForceCollisionOperator* force_collision = new ForceCollisionOperator(fForcedCollisionParticles);
+    force_collision->AttachTo(fLogicTarget);
+  }
+
+  // FAST SIMULATION ///////////////////////////////////////
+
+  // the model registers itself with the target region, which outlives a
+  // rebuilt geometry, so each thread makes it once; it is idle until
+  // /fastsim/electron_energy is set
+  static G4ThreadLocal FastElectronModel* fast_electron_model = 0;
+  if (fFastElectrons && !fast_electron_model) {
+    fast_electron_model =
+      new FastElectronModel("FastElectron", G4RegionStore::GetInstance()->GetRegion("Target"), tracking_sd);
+  }
+
   //////////////////////////////////////////////////////////
 }
 
+void DetectorConstruction::SetupRegion(G4String const& name, G4LogicalVolume* logic, G4double cut)
+{
+  G4Region* region = G4RegionStore::GetInstance()->GetRegion(name, false);
+  if (!region) region = new G4Region(name);
+
+  // a rebuilt geometry leaves the volumes of the previous one in the region
+  std::vector<G4LogicalVolume*> old_volumes(region->GetRootLogicalVolumeIterator(),
+    region->GetRootLogicalVolumeIterator() + region->GetNumberOfRootVolumes());
+  for (auto volume : old_volumes) region->RemoveRootLogicalVolume(volume);
+
+  region->AddRootLogicalVolume(logic);
+
+  SetRegionCut(region, cut);
+}
+
+void DetectorConstruction::SetRegionCut(G4Region* region, G4double cut)
+{
+  // a region without production cuts of its own is given the default cuts
+  // at initialization, which must not be changed here
+  G4ProductionCuts* default_cuts = G4ProductionCutsTable::GetProductionCutsTable()->GetDefaultProductionCuts();
+  if (cut > 0.) {
+    G4ProductionCuts* cuts = region->GetProductionCuts();
+    if (!cuts || cuts == default_cuts) {
+      cuts = new G4ProductionCuts();
+      region->SetProductionCuts(cuts);
+    }
+    cuts->SetProductionCut(cut);
+  }
+  else {
+    region->SetProductionCuts(default_cuts);
+  }
+}
+
 void DetectorConstruction::PrintParameters()
 {
 
@@ -236,6 +334,12 @@ void DetectorConstruction::PrintParameters()
          << " Thickness = " << G4BestUnit(fWallThickness,"Length")
          << " Material = " << fWallMater->GetName();
 
+  G4cout << "\n Passive cuts : Shield = " << G4BestUnit(fShieldCut,"Length")
+         << " Vacuum = " << G4BestUnit(fVacuumCut,"Length")
+         << " Wall = " << G4BestUnit(fWallCut,"Length")
+         << " Min Ekin = " << G4BestUnit(fPassiveMinEkin,"Energy")
+         << " Max Time = " << G4BestUnit(fPassiveMaxTime,"Time");
+
   G4cout << "\n" << fTargetMater << "\n" << fShieldMater << "\n" << fVacuumMater << "\n" << fWallMater << G4endl;
 
 }
@@ -352,82 +456,141 @@ void DetectorConstruction::SetWallLength(G4double value)
   G4RunManager::GetRunManager()->ReinitializeGeometry();
 }
 
-G4double DetectorConstruction::GetTargetLength()
+void DetectorConstruction::SetShieldCut(G4double value)
+{
+  fShieldCut = value;
+  UpdateRegionCut("Shield", value);
+}
+
+void DetectorConstruction::SetVacuumCut(G4double value)
+{
+  fVacuumCut = value;
+  UpdateRegionCut("Vacuum", value);
+}
+
+void DetectorConstruction::SetWallCut(G4double value)
+{
+  fWallCut = value;
+  UpdateRegionCut("Wall", value);
+}
+
+void DetectorConstruction::UpdateRegionCut(G4String const& name, G4double cut)
+{
+  // before the geometry is built the cut is set up with the region; after,
+  // the cuts table picks the changed cuts up at the next run, without a
+  // rebuild of the geometry
+  G4Region* region = G4RegionStore::GetInstance()->GetRegion(name, false);
+  if (region) SetRegionCut(region, cut);
+}
+
+void DetectorConstruction::SetPassiveMinEkin(G4double value)
+{
+  fPassiveMinEkin = value;
+  G4RunManager::GetRunManager()->ReinitializeGeometry();
+}
+
+void DetectorConstruction::SetPassiveMaxTime(G4double value)
+{
+  fPassiveMaxTime = value;
+  G4RunManager::GetRunManager()->ReinitializeGeometry();
+}
+
+G4bool DetectorConstruction::HasPassiveLimits() const
+{
+  return fPassiveMinEkin > 0. || fPassiveMaxTime > 0.;
+}
+
+void DetectorConstruction::AddForcedCollision(G4String const& particle)
+{
+  fForcedCollisionParticles.push_back(particle);
+}
+
+void DetectorConstruction::EnableFastElectrons()
+{
+  fFastElectrons = true;
+}
+
+G4double DetectorConstruction::GetTargetLength() const
 {
   return fTargetLength;
 }
 
-G4double DetectorConstruction::GetTargetRadius()
+G4double DetectorConstruction::GetTargetRadius() const
 {
   return fTargetRadius;
 }
 
-G4Material* DetectorConstruction::GetTargetMaterial()
+G4Material* DetectorConstruction::GetTargetMaterial() const
 {
   return fTargetMater;
 }
 
-G4LogicalVolume* DetectorConstruction::GetLogicTarget()
+G4LogicalVolume* DetectorConstruction::GetLogicTarget() const
 {
   return fLogicTarget;
 }
 
-G4double DetectorConstruction::GetShieldLength()
+G4double DetectorConstruction::GetTargetMass() const
+{
+  return fTargetMater->GetDensity() * pi * fTargetRadius * fTargetRadius * fTargetLength;
+}
+
+G4double DetectorConstruction::GetShieldLength() const
 {
   return fShieldLength;
 }
 
-G4double DetectorConstruction::GetShieldThickness()
+G4double DetectorConstruction::GetShieldThickness() const
 {
-  return fShieldRadius;
+  return fShieldThickness;
 }
 
-G4Material* DetectorConstruction::GetShieldMaterial()
+G4Material* DetectorConstruction::GetShieldMaterial() const
 {
   return fShieldMater;
 }
 
-G4LogicalVolume* DetectorConstruction::GetLogicShield()
+G4LogicalVolume* DetectorConstruction::GetLogicShield() const
 {
   return fLogicShield;
 }
 
-G4double DetectorConstruction::GetVacuumLength()
+G4double DetectorConstruction::GetVacuumLength() const
 {
   return fVacuumLength;
 }
 
-G4double DetectorConstruction::GetVacuumThickness()
+G4double DetectorConstruction::GetVacuumThickness() const
 {
   return fVacuumThickness;
 }
 
-G4Material* DetectorConstruction::GetVacuumMaterial()
+G4Material* DetectorConstruction::GetVacuumMaterial() const
 {
   return fVacuumMater;
 }
 
-G4LogicalVolume* DetectorConstruction::GetLogicVacuum()
+G4LogicalVolume* DetectorConstruction::GetLogicVacuum() const
 {
   return fLogicVacuum;
 }
 
-G4double DetectorConstruction::GetWallLength()
+G4double DetectorConstruction::GetWallLength() const
 {
   return fWallLength;
 }
 
-G4double DetectorConstruction::GetWallThickness()
+G4double DetectorConstruction::GetWallThickness() const
 {
   return fWallThickness;
 }
 
-G4Material* DetectorConstruction::GetWallMaterial()
+G4Material* DetectorConstruction::GetWallMaterial() const
 {
   return fWallMater;
 }
 
-G4LogicalVolume* DetectorConstruction::GetLogicWall()
+G4LogicalVolume* DetectorConstruction::GetLogicWall() const
 {
   return fLogicWall;
 }
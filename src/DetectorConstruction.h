@@ -12,7 +12,11 @@
 #include "G4VUserDetectorConstruction.hh"
 #include "DetectorMessenger.hh"
 
+#include <vector>
+
 class G4Material;
+class G4Region;
+class G4UserLimits;
 
 
 class DetectorConstruction: public G4VUserDetectorConstruction
@@ -24,25 +28,28 @@ public:
 
 public:
     
-  G4double GetTargetLength();
-  G4double GetTargetRadius();
-  G4Material* GetTargetMaterial();       
-  G4LogicalVolume* GetLogicTarget();
-
-  G4double GetShieldLength();
-  G4double GetShieldThickness();
-  G4Material* GetShieldMaterial();       
-  G4LogicalVolume* GetLogicShield();
-
-  G4double GetVacuumLength();
-  G4double GetVacuumThickness();
-  G4Material* GetVacuumMaterial();       
-  G4LogicalVolume* GetLogicVacuum();
-
-  G4double GetWallLength();
-  G4double GetWallThickness();
-  G4Material* GetWallMaterial();       
-  G4LogicalVolume* GetLogicWall();
+  G4double GetTargetLength() const;
+  G4double GetTargetRadius() const;
+  G4Material* GetTargetMaterial() const;       
+  G4LogicalVolume* GetLogicTarget() const;
+
+  // mass of the target
+  G4double GetTargetMass() const;
+
+  G4double GetShieldLength() const;
+  G4double GetShieldThickness() const;
+  G4Material* GetShieldMaterial() const;       
+  G4LogicalVolume* GetLogicShield() const;
+
+  G4double GetVacuumLength() const;
+  G4double GetVacuumThickness() const;
+  G4Material* GetVacuumMaterial() const;       
+  G4LogicalVolume* GetLogicVacuum() const;
+
+  G4double GetWallLength() const;
+  G4double GetWallThickness() const;
+  G4Material* GetWallMaterial() const;       
+  G4LogicalVolume* GetLogicWall() const;
   
   void PrintParameters();
 
@@ -64,11 +71,38 @@ public:
   void SetWallThickness (G4double value);
   void SetWallMaterial (G4String);
 
+  // production cuts of the passive volumes (0 keeps the default cuts), which
+  // can be changed between runs without rebuilding the geometry, and the
+  // minimum kinetic energy and maximum time of tracks in them (0 for no
+  // limit); the target always keeps the default cuts and no limits
+  void SetShieldCut (G4double value);
+  void SetVacuumCut (G4double value);
+  void SetWallCut (G4double value);
+  void SetPassiveMinEkin (G4double value);
+  void SetPassiveMaxTime (G4double value);
+
+  // whether a minimum kinetic energy or maximum time is set; the limits
+  // need PassiveLimitsPhysics, so they can only be set before
+  // /run/initialize
+  G4bool HasPassiveLimits () const;
+
+  // force at least one interaction of this particle type in the target,
+  // through G4 generic biasing; the physics of the particle must be
+  // wrapped by G4GenericBiasingPhysics
+  void AddForcedCollision (G4String const& particle);
+
+  // parameterize low-energy electrons in the target (FastElectronModel);
+  // e- must be activated in G4FastSimulationPhysics
+  void EnableFastElectrons ();
+
 private:
 
   virtual G4VPhysicalVolume* Construct();
   virtual void ConstructSDandField();
           void DefineMaterials();
+          void SetupRegion(G4String const&, G4LogicalVolume*, G4double cut);
+          void SetRegionCut(G4Region*, G4double cut);
+          void UpdateRegionCut(G4String const&, G4double cut);
 
 private:
 
@@ -92,6 +126,16 @@ private:
   G4Material*        fWallMater;
   G4LogicalVolume*   fLogicWall;
 
+  G4double           fShieldCut;
+  G4double           fVacuumCut;
+  G4double           fWallCut;
+  G4double           fPassiveMinEkin;
+  G4double           fPassiveMaxTime;
+  G4UserLimits*      fPassiveLimits;
+
+  std::vector<G4String> fForcedCollisionParticles;
+  G4bool             fFastElectrons;
+
   G4double           fWorldLength;
   G4double           fWorldRadius;
   G4Material*        fWorldMater;
@@ -44,7 +44,9 @@ DetectorMessenger::DetectorMessenger(DetectorConstruction* Det)
  fDetector(Det), fRdecayDir(0), fDetDir(0),
  fTargMatCmd(0),
  fTargRadiusCmd(0),
- fTargLengthCmd(0)
+ fTargLengthCmd(0),
+ fShieldCutCmd(0), fVacuumCutCmd(0), fWallCutCmd(0),
+ fPassiveMinEkinCmd(0), fPassiveMaxTimeCmd(0)
 { 
   fRdecayDir = new G4UIdirectory("/directionality02/");
   fRdecayDir->SetGuidance("commands specific to this example");
@@ -72,6 +74,46 @@ DetectorMessenger::DetectorMessenger(DetectorConstruction* Det)
   fTargLengthCmd->SetUnitCategory("Length");
   fTargLengthCmd->SetParameterName("choice",false);
   fTargLengthCmd->AvailableForStates(G4State_PreInit);
+
+  fShieldCutCmd =
+       new G4UIcmdWithADoubleAndUnit("/directionality02/det/setShieldCut", this);
+  fShieldCutCmd->SetGuidance("Set the production cut of the Shield region (0: default cut).");
+  fShieldCutCmd->SetUnitCategory("Length");
+  fShieldCutCmd->SetParameterName("cut",false);
+  fShieldCutCmd->SetRange("cut>=0.");
+  fShieldCutCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fVacuumCutCmd =
+       new G4UIcmdWithADoubleAndUnit("/directionality02/det/setVacuumCut", this);
+  fVacuumCutCmd->SetGuidance("Set the production cut of the Vacuum region (0: default cut).");
+  fVacuumCutCmd->SetUnitCategory("Length");
+  fVacuumCutCmd->SetParameterName("cut",false);
+  fVacuumCutCmd->SetRange("cut>=0.");
+  fVacuumCutCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fWallCutCmd =
+       new G4UIcmdWithADoubleAndUnit("/directionality02/det/setWallCut", this);
+  fWallCutCmd->SetGuidance("Set the production cut of the Wall region (0: default cut).");
+  fWallCutCmd->SetUnitCategory("Length");
+  fWallCutCmd->SetParameterName("cut",false);
+  fWallCutCmd->SetRange("cut>=0.");
+  fWallCutCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPassiveMinEkinCmd =
+       new G4UIcmdWithADoubleAndUnit("/directionality02/det/setPassiveMinEkin", this);
+  fPassiveMinEkinCmd->SetGuidance("Kill tracks below this kinetic energy in the Shield, Vacuum and Wall (0: no limit); set before /run/initialize.");
+  fPassiveMinEkinCmd->SetUnitCategory("Energy");
+  fPassiveMinEkinCmd->SetParameterName("ekin",false);
+  fPassiveMinEkinCmd->SetRange("ekin>=0.");
+  fPassiveMinEkinCmd->AvailableForStates(G4State_PreInit);
+
+  fPassiveMaxTimeCmd =
+       new G4UIcmdWithADoubleAndUnit("/directionality02/det/setPassiveMaxTime", this);
+  fPassiveMaxTimeCmd->SetGuidance("Kill tracks after this global time in the Shield, Vacuum and Wall (0: no limit); set before /run/initialize.");
+  fPassiveMaxTimeCmd->SetUnitCategory("Time");
+  fPassiveMaxTimeCmd->SetParameterName("time",false);
+  fPassiveMaxTimeCmd->SetRange("time>=0.");
+  fPassiveMaxTimeCmd->AvailableForStates(G4State_PreInit);
   
 }
 
@@ -82,6 +124,11 @@ DetectorMessenger::~DetectorMessenger()
   delete fTargMatCmd;
   delete fTargRadiusCmd;
   delete fTargLengthCmd;
+  delete fShieldCutCmd;
+  delete fVacuumCutCmd;
+  delete fWallCutCmd;
+  delete fPassiveMinEkinCmd;
+  delete fPassiveMaxTimeCmd;
   delete fDetDir;
   delete fRdecayDir;  
 }
@@ -98,6 +145,21 @@ void DetectorMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
     
   if (command == fTargRadiusCmd ) 
     {fDetector->SetTargetRadius(fTargLengthCmd->GetNewDoubleValue(newValue));}
+
+  if (command == fShieldCutCmd )
+    { fDetector->SetShieldCut(fShieldCutCmd->GetNewDoubleValue(newValue));}
+
+  if (command == fVacuumCutCmd )
+    { fDetector->SetVacuumCut(fVacuumCutCmd->GetNewDoubleValue(newValue));}
+
+  if (command == fWallCutCmd )
+    { fDetector->SetWallCut(fWallCutCmd->GetNewDoubleValue(newValue));}
+
+  if (command == fPassiveMinEkinCmd )
+    { fDetector->SetPassiveMinEkin(fPassiveMinEkinCmd->GetNewDoubleValue(newValue));}
+
+  if (command == fPassiveMaxTimeCmd )
+    { fDetector->SetPassiveMaxTime(fPassiveMaxTimeCmd->GetNewDoubleValue(newValue));}
     
 }
 
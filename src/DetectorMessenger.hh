@@ -62,6 +62,12 @@ class DetectorMessenger: public G4UImessenger
     G4UIcmdWithADoubleAndUnit* fTargRadiusCmd;
     G4UIcmdWithADoubleAndUnit* fTargLengthCmd;
 
+    G4UIcmdWithADoubleAndUnit* fShieldCutCmd;
+    G4UIcmdWithADoubleAndUnit* fVacuumCutCmd;
+    G4UIcmdWithADoubleAndUnit* fWallCutCmd;
+    G4UIcmdWithADoubleAndUnit* fPassiveMinEkinCmd;
+    G4UIcmdWithADoubleAndUnit* fPassiveMaxTimeCmd;
+
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
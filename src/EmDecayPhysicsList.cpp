@@ -0,0 +1,27 @@
+// -----------------------------------------------------------------------------
+//  G4_QPIX | EmDecayPhysicsList.cpp
+//
+//  Lightweight physics list: electromagnetic physics and radioactive decay.
+//   * Author: Everybody is an author!
+//   * Creation date: 16 Oct 2026
+// -----------------------------------------------------------------------------
+
+#include "EmDecayPhysicsList.h"
+
+// GEANT4 includes
+#include "G4DecayPhysics.hh"
+#include "G4EmStandardPhysics_option4.hh"
+#include "G4RadioactiveDecayPhysics.hh"
+
+
+EmDecayPhysicsList::EmDecayPhysicsList(): G4VModularPhysicsList()
+{
+    RegisterPhysics(new G4EmStandardPhysics_option4());
+    RegisterPhysics(new G4DecayPhysics());
+    RegisterPhysics(new G4RadioactiveDecayPhysics());
+}
+
+
+EmDecayPhysicsList::~EmDecayPhysicsList()
+{
+}
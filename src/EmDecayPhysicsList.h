@@ -0,0 +1,26 @@
+// -----------------------------------------------------------------------------
+//  G4_QPIX | EmDecayPhysicsList.h
+//
+//  Lightweight physics list: electromagnetic physics and radioactive decay.
+//   * Author: Everybody is an author!
+//   * Creation date: 16 Oct 2026
+// -----------------------------------------------------------------------------
+
+#ifndef EM_DECAY_PHYSICS_LIST_H
+#define EM_DECAY_PHYSICS_LIST_H
+
+#include <G4VModularPhysicsList.hh>
+
+
+// Physics list "EM_RDM", for beta/gamma background runs and single-particle
+// macros that need neither hadronic physics nor the high-precision neutron
+// data: G4EmStandardPhysics_option4, decays and radioactive decay.
+class EmDecayPhysicsList: public G4VModularPhysicsList
+{
+    public:
+
+        EmDecayPhysicsList();
+        virtual ~EmDecayPhysicsList();
+};
+
+#endif
@@ -9,20 +9,27 @@
 #include "EventAction.h"
 
 // Q-Pix includes
+#include "AllocationCounter.h"
 #include "AnalysisManager.h"
 #include "MCTruthManager.h"
+#include "StartupTiming.h"
 
 // GEANT4 includes
 #include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
 #include "G4GenericMessenger.hh"
 
 
 EventAction::EventAction():
-  G4UserEventAction(), event_id_offset_(0), energy_threshold_(0.)
+  G4UserEventAction(), event_id_offset_(0), energy_threshold_(0.), prune_(false),
+  max_truth_memory_(0), chunk_(0)
 {
     msg_ = new G4GenericMessenger(this, "/event/", "user-defined event configuration");
     msg_->DeclareProperty("offset", event_id_offset_, "Event ID offset.");
     msg_->DeclareProperty("energy_threshold", energy_threshold_, "Events that deposit less energy than this energy threshold will not be saved.").SetUnit("MeV");
+    msg_->DeclareProperty("prune", prune_, "Only save particles that deposit energy, their ancestors and particles with the PDG codes given to keep_pdg.");
+    msg_->DeclareMethod("keep_pdg", &EventAction::AddKeepPDGCode, "PDG code of particles to save when pruning.");
+    msg_->DeclareProperty("max_truth_memory", max_truth_memory_, "Write the finished part of the MC truth of an event out in chunks whenever it takes more than this memory, in MB (0: write whole events).");
 }
 
 
@@ -31,8 +38,18 @@ EventAction::~EventAction()
 }
 
 
-void EventAction::BeginOfEventAction(const G4Event*)
+void EventAction::BeginOfEventAction(const G4Event* event)
 {
+    AllocationCounter::SetPhase(AllocationCounter::kTracking);
+
+    // the primaries get the first track IDs
+    int number_primaries = 0;
+    for (int vertex = 0; vertex < event->GetNumberOfPrimaryVertex(); ++vertex)
+    {
+        number_primaries += event->GetPrimaryVertex(vertex)->GetNumberOfParticle();
+    }
+    MCTruthManager::Instance()->SetNumberPrimaries(number_primaries);
+
     // int mod = event->GetEventID() % 1000;
     // if (mod == 0)
     // {
@@ -41,23 +58,28 @@ void EventAction::BeginOfEventAction(const G4Event*)
 }
 
 
+void EventAction::AddKeepPDGCode(int pdg_code)
+{
+    keep_pdg_codes_.push_back(pdg_code);
+}
+
+
 void EventAction::EndOfEventAction(const G4Event* event)
 {
+    StartupTiming::Record(StartupTiming::kFirstEvent);
+
+    AllocationCounter::SetPhase(AllocationCounter::kTruth);
+
     // get MC truth manager
     MCTruthManager * mc_truth_manager = MCTruthManager::Instance();
 
-    // get map of particles from MC truth manager
-    auto const MCParticleMap = mc_truth_manager->GetMCParticleMap();
-
-    double energy_deposited = 0.;
+    // get analysis manager
+    AnalysisManager * analysis_manager = AnalysisManager::Instance();
 
-    // add particle to analysis manager
-    for (auto const& p : MCParticleMap)
-    {
-        auto const& particle = p.second;
-        energy_deposited += particle->EnergyDeposited();
-        // std::cout << "Energy deposited by particle PDG (" << particle->PDGCode() << "): " << particle->EnergyDeposited() << std::endl;
-    }
+    // sum the energy deposited straight from the hit and voxel columns, so
+    // that events below the threshold never build their output record
+    double const energy_deposited = mc_truth_manager->GetHits().EnergyDeposit()
+                                  + mc_truth_manager->GetVoxels().EnergyDeposit();
 
     int mod = event->GetEventID() % 1000;
     if (mod == 0)
@@ -67,39 +89,38 @@ void EventAction::EndOfEventAction(const G4Event* event)
         // G4cout << "Total energy deposited: " << energy_deposited << G4endl;
     }
 
-    // don't save event if total energy deposited is below the energy threshold
-    if (energy_deposited < energy_threshold_)
+    // don't save event if total energy deposited is below the energy threshold;
+    // a sub-event, or the last chunk of an event, is only part of its event,
+    // so the cut can't be applied to it; the merge applies it to the readout
+    // window reassembled from the sub-events
+    if (mc_truth_manager->NumberSubEvents() < 2 && chunk_ == 0 && energy_deposited < energy_threshold_)
     {
-        // get analysis manager
-        AnalysisManager * analysis_manager = AnalysisManager::Instance();
-
         // reset event variables
         analysis_manager->EventReset();
 
         // reset event in MC truth manager
         mc_truth_manager->EventReset();
 
+        AllocationCounter::EndEvent();
+
         return;
     }
 
-    // get analysis manager
-    AnalysisManager * analysis_manager = AnalysisManager::Instance();
+    // every track of the event has finished; this also closes particles
+    // with secondaries that were never tracked
+    mc_truth_manager->CloseAll();
+
+    this->AddTruth();
 
     // set event number
     // event->SetEventID(event->GetEventID() + event_id_offset_);
     // analysis_manager->SetEvent(event->GetEventID());
-    analysis_manager->SetEvent(event->GetEventID() + event_id_offset_);
-
-    // get map of particles from MC truth manager
-    // auto const MCParticleMap = mc_truth_manager->GetMCParticleMap();
-
-    // add particle to analysis manager
-    for (auto const& p : MCParticleMap)
-    {
-        auto const& particle = p.second;
+    // sub-events of one readout window share the event number of the window
+    analysis_manager->SetEvent(mc_truth_manager->Event() + event_id_offset_);
+    analysis_manager->SetSubEvent(mc_truth_manager->SubEvent());
+    analysis_manager->SetChunk(chunk_);
 
-        analysis_manager->AddMCParticle(particle);
-    }
+    AllocationCounter::SetPhase(AllocationCounter::kFill);
 
     // write event to ROOT file and reset event variables
     analysis_manager->EventFill();
@@ -107,5 +128,62 @@ void EventAction::EndOfEventAction(const G4Event* event)
 
     // reset event in MC truth manager
     mc_truth_manager->EventReset();
+
+    chunk_ = 0;
+
+    AllocationCounter::EndEvent();
+}
+
+
+void EventAction::WriteChunk()
+{
+    // get MC truth manager
+    MCTruthManager * mc_truth_manager = MCTruthManager::Instance();
+
+    // get analysis manager
+    AnalysisManager * analysis_manager = AnalysisManager::Instance();
+
+    this->AddTruth();
+
+    analysis_manager->SetEvent(mc_truth_manager->Event() + event_id_offset_);
+    analysis_manager->SetSubEvent(mc_truth_manager->SubEvent());
+    analysis_manager->SetChunk(chunk_);
+
+    analysis_manager->EventFill();
+    analysis_manager->ChunkReset();
+
+    // the written particles make room for the rest of the event
+    mc_truth_manager->ReleaseClosed();
+
+    chunk_ += 1;
 }
 
+
+void EventAction::AddTruth()
+{
+    // get MC truth manager
+    MCTruthManager * mc_truth_manager = MCTruthManager::Instance();
+
+    // get analysis manager
+    AnalysisManager * analysis_manager = AnalysisManager::Instance();
+
+    // drop the particles that never reached the sensitive volume
+    if (prune_) mc_truth_manager->Prune(keep_pdg_codes_);
+
+    // get particles from MC truth manager, in track ID order
+    auto const & MCParticles = mc_truth_manager->GetMCParticles();
+
+    // add particle to analysis manager; particles with open descendants
+    // wait for a later chunk
+    for (auto const particle : MCParticles)
+    {
+        if (!particle || !particle->Closed()) continue;
+
+        analysis_manager->AddMCParticle(particle);
+    }
+
+    // hand the hit and voxel columns over to the analysis manager, which also
+    // sums up the energy deposited
+    analysis_manager->AddHits(mc_truth_manager->GetHits());
+    analysis_manager->AddVoxels(mc_truth_manager->GetVoxels());
+}
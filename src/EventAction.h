@@ -11,6 +11,8 @@
 
 #include <G4UserEventAction.hh>
 
+#include <vector>
+
 
 class G4GenericMessenger;
 
@@ -23,11 +25,34 @@ class EventAction: public G4UserEventAction
         virtual void BeginOfEventAction(const G4Event*);
         virtual void EndOfEventAction(const G4Event*);
 
+        void AddKeepPDGCode(int);
+
+        // memory bound of the MC truth of an event, in MB; 0 for none
+        inline int MaxTruthMemory() const { return max_truth_memory_; }
+
+        // events that deposit less energy are not saved
+        inline double EnergyThreshold() const { return energy_threshold_; }
+
+        // write the particles that are closed, and the hits and voxels made
+        // so far, as the next chunk of the current event
+        void WriteChunk();
+
     private:
 
         G4GenericMessenger* msg_; // Messenger for configuration parameters
         int event_id_offset_;
         double energy_threshold_;
+
+        // truth pruning; particles with these PDG codes are always kept
+        bool prune_;
+        std::vector< int > keep_pdg_codes_;
+
+        int max_truth_memory_;
+
+        // index of the next chunk of the current event
+        int chunk_;
+
+        void AddTruth();
 };
 
 #endif
@@ -0,0 +1,149 @@
+// -----------------------------------------------------------------------------
+//  EventRecord.cpp
+//
+//  Class definition of the event record
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#include "EventRecord.h"
+
+// C++ includes
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+void EventRecord::Branch(TTree * tree)
+{
+    tree->Branch("run",   &run_,   "run/I");
+    tree->Branch("event", &event_, "event/I");
+
+    tree->Branch("number_particles", &number_particles_, "number_particles/I");
+    tree->Branch("number_hits",      &number_hits_,      "number_hits/I");
+
+    tree->Branch("energy_deposit",   &energy_deposit_,   "energy_deposit/D");
+
+    tree->Branch("particle_track_id",        &particle_track_id_);
+    tree->Branch("particle_parent_track_id", &particle_parent_track_id_);
+    tree->Branch("particle_pdg_code",        &particle_pdg_code_);
+    tree->Branch("particle_mass",            &particle_mass_);
+    tree->Branch("particle_charge",          &particle_charge_);
+    tree->Branch("particle_process_key",     &particle_process_key_);
+    tree->Branch("particle_total_occupancy", &particle_total_occupancy_);
+    tree->Branch("particle_weight",          &particle_weight_);
+    tree->Branch("particle_initial_x",       &particle_initial_x_);
+    tree->Branch("particle_initial_y",       &particle_initial_y_);
+    tree->Branch("particle_initial_z",       &particle_initial_z_);
+    tree->Branch("particle_initial_t",       &particle_initial_t_);
+    tree->Branch("particle_initial_px",      &particle_initial_px_);
+    tree->Branch("particle_initial_py",      &particle_initial_py_);
+    tree->Branch("particle_initial_pz",      &particle_initial_pz_);
+    tree->Branch("particle_initial_energy",  &particle_initial_energy_);
+
+    tree->Branch("particle_number_daughters",  &particle_number_daughters_);
+    tree->Branch("particle_daughter_track_id", &particle_daughter_track_ids_);
+
+    hits_.Branch(tree);
+}
+
+//-----------------------------------------------------------------------------
+void EventRecord::BranchVoxels(TTree * tree)
+{
+    tree->Branch("number_voxels", &number_voxels_, "number_voxels/I");
+
+    voxels_.Branch(tree);
+}
+
+//-----------------------------------------------------------------------------
+void EventRecord::ShiftTrackIDs(int const offset)
+{
+    for (auto & track_id : particle_track_id_) track_id += offset;
+    for (auto & track_id : particle_parent_track_id_) if (track_id > 0) track_id += offset;
+    for (auto & daughters : particle_daughter_track_ids_)
+    {
+        for (auto & track_id : daughters) track_id += offset;
+    }
+    for (auto & track_id : hits_.track_id_) track_id += offset;
+}
+
+//-----------------------------------------------------------------------------
+void EventRecord::Reset()
+{
+    event_ = -1;
+    sub_event_ = 0;
+    chunk_ = 0;
+    number_particles_ = 0;
+
+    number_hits_ = 0;
+    number_voxels_ = 0;
+    energy_deposit_ = 0;
+
+    particle_track_id_.clear();
+    particle_parent_track_id_.clear();
+    particle_pdg_code_.clear();
+    particle_mass_.clear();
+    particle_charge_.clear();
+    particle_process_key_.clear();
+    particle_total_occupancy_.clear();
+    particle_weight_.clear();
+
+    particle_number_daughters_.clear();
+    particle_daughter_track_ids_.clear();
+
+    particle_initial_x_.clear();
+    particle_initial_y_.clear();
+    particle_initial_z_.clear();
+    particle_initial_t_.clear();
+
+    particle_initial_px_.clear();
+    particle_initial_py_.clear();
+    particle_initial_pz_.clear();
+    particle_initial_energy_.clear();
+
+    hits_.Clear();
+    voxels_.Clear();
+}
+
+//-----------------------------------------------------------------------------
+void EventRecord::Append(EventRecord const & other, double const voxel_time_bin)
+{
+    // track IDs restart at 1 in every sub-event
+    int offset = 0;
+    for (auto const track_id : particle_track_id_) offset = std::max(offset, track_id);
+
+    auto shift = [offset] (int const track_id) { return track_id > 0 ? track_id + offset : track_id; };
+
+    number_particles_ += other.number_particles_;
+    number_hits_      += other.number_hits_;
+    number_voxels_    += other.number_voxels_;
+    energy_deposit_   += other.energy_deposit_;
+
+    for (auto const track_id : other.particle_track_id_) particle_track_id_.push_back(shift(track_id));
+    for (auto const track_id : other.particle_parent_track_id_) particle_parent_track_id_.push_back(shift(track_id));
+
+    particle_pdg_code_.insert(particle_pdg_code_.end(), other.particle_pdg_code_.begin(), other.particle_pdg_code_.end());
+    particle_mass_.insert(particle_mass_.end(), other.particle_mass_.begin(), other.particle_mass_.end());
+    particle_charge_.insert(particle_charge_.end(), other.particle_charge_.begin(), other.particle_charge_.end());
+    particle_process_key_.insert(particle_process_key_.end(), other.particle_process_key_.begin(), other.particle_process_key_.end());
+    particle_total_occupancy_.insert(particle_total_occupancy_.end(), other.particle_total_occupancy_.begin(), other.particle_total_occupancy_.end());
+    particle_weight_.insert(particle_weight_.end(), other.particle_weight_.begin(), other.particle_weight_.end());
+
+    particle_number_daughters_.insert(particle_number_daughters_.end(), other.particle_number_daughters_.begin(), other.particle_number_daughters_.end());
+    for (auto const & daughters : other.particle_daughter_track_ids_)
+    {
+        particle_daughter_track_ids_.emplace_back();
+        for (auto const track_id : daughters) particle_daughter_track_ids_.back().push_back(shift(track_id));
+    }
+
+    particle_initial_x_.insert(particle_initial_x_.end(), other.particle_initial_x_.begin(), other.particle_initial_x_.end());
+    particle_initial_y_.insert(particle_initial_y_.end(), other.particle_initial_y_.begin(), other.particle_initial_y_.end());
+    particle_initial_z_.insert(particle_initial_z_.end(), other.particle_initial_z_.begin(), other.particle_initial_z_.end());
+    particle_initial_t_.insert(particle_initial_t_.end(), other.particle_initial_t_.begin(), other.particle_initial_t_.end());
+
+    particle_initial_px_.insert(particle_initial_px_.end(), other.particle_initial_px_.begin(), other.particle_initial_px_.end());
+    particle_initial_py_.insert(particle_initial_py_.end(), other.particle_initial_py_.begin(), other.particle_initial_py_.end());
+    particle_initial_pz_.insert(particle_initial_pz_.end(), other.particle_initial_pz_.begin(), other.particle_initial_pz_.end());
+    particle_initial_energy_.insert(particle_initial_energy_.end(), other.particle_initial_energy_.begin(), other.particle_initial_energy_.end());
+
+    hits_.Append(other.hits_, offset);
+    voxels_.Append(other.voxels_, voxel_time_bin);
+}
@@ -0,0 +1,91 @@
+// -----------------------------------------------------------------------------
+//  EventRecord.h
+//
+//  Class definition of the event record
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#ifndef EventRecord_h
+#define EventRecord_h 1
+
+// Q-Pix includes
+#include "HitBuffer.h"
+#include "VoxelBuffer.h"
+
+// ROOT includes
+#include "TTree.h"
+
+// C++ includes
+#include <vector>
+
+// variables that go into one entry of the event tree
+struct EventRecord
+{
+    int run_ = -1;
+    int event_ = -1;
+
+    // index of the sub-event within the event; only written to the
+    // per-worker files, the merge reassembles the sub-events
+    int sub_event_ = 0;
+
+    // index of the chunk within the (sub-)event, when the truth is written
+    // out in chunks to bound the memory
+    int chunk_ = 0;
+
+    int number_particles_ = 0;
+    int number_hits_ = 0;
+    int number_voxels_ = 0;
+
+    // energy deposited by the hits or voxels (MeV); like them it is not
+    // weighted in a biased run, in either output mode
+    double energy_deposit_ = 0;
+
+    std::vector< int >    particle_track_id_;
+    std::vector< int >    particle_parent_track_id_;
+    std::vector< int >    particle_pdg_code_;
+    std::vector< double > particle_mass_;
+    std::vector< double > particle_charge_;
+    std::vector< int >    particle_process_key_;
+    std::vector< int >    particle_total_occupancy_;
+    std::vector< float >  particle_weight_;
+
+    std::vector< int >                particle_number_daughters_;
+    std::vector< std::vector< int > > particle_daughter_track_ids_;
+
+    std::vector< Coordinate_t > particle_initial_x_;
+    std::vector< Coordinate_t > particle_initial_y_;
+    std::vector< Coordinate_t > particle_initial_z_;
+    std::vector< double >       particle_initial_t_;
+
+    std::vector< Coordinate_t > particle_initial_px_;
+    std::vector< Coordinate_t > particle_initial_py_;
+    std::vector< Coordinate_t > particle_initial_pz_;
+    std::vector< double >       particle_initial_energy_;
+
+    // hit columns, swapped in from the MC truth manager
+    HitBuffer hits_;
+
+    // voxel columns, swapped in from the MC truth manager in voxel mode
+    VoxelBuffer voxels_;
+
+    // create the event tree branches, bound to this record
+    void Branch(TTree *);
+
+    // create the voxel branches of the event tree, for the voxel mode
+    void BranchVoxels(TTree *);
+
+    // move all the track IDs up by the given offset
+    void ShiftTrackIDs(int const);
+
+    // clear the event variables, keeping the run number and the capacity
+    void Reset();
+
+    // append the particles, hits and voxels of another sub-event of the same
+    // event, shifting its track IDs past the ones already in this record. A
+    // voxel hit in several sub-events is summed into one entry per voxel time
+    // bin (ns; second argument).
+    void Append(EventRecord const &, double const);
+};
+
+#endif
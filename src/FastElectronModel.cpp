@@ -0,0 +1,157 @@
+// -----------------------------------------------------------------------------
+//  G4_QPIX | FastElectronModel.cpp
+//
+//  Parameterized energy deposition of low-energy electrons in the target.
+//   * Author: Everybody is an author!
+//   * Creation date: 16 Oct 2026
+// -----------------------------------------------------------------------------
+
+#include "FastElectronModel.h"
+
+// GEANT4 includes
+#include "G4Electron.hh"
+#include "G4FastStep.hh"
+#include "G4FastTrack.hh"
+#include "G4GenericMessenger.hh"
+#include "G4Material.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4VSensitiveDetector.hh"
+#include "G4VSolid.hh"
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+
+
+FastElectronModel::FastElectronModel(G4String const & name, G4Region * envelope,
+                                     G4VSensitiveDetector * sensitive_detector):
+  G4VFastSimulationModel(name, envelope),
+  sensitive_detector_(sensitive_detector),
+  max_energy_(0.),
+  segment_energy_(10.*keV)
+{
+    msg_ = new G4GenericMessenger(this, "/fastsim/", "Control commands of the fast simulation of electrons.");
+    msg_->DeclareProperty("electron_energy", max_energy_,
+        "Deposit the energy of electrons below this kinetic energy along their range instead of tracking them (0: track all).").SetUnit("keV");
+    msg_->DeclareMethodWithUnit("electron_segment_energy", "keV", &FastElectronModel::SetSegmentEnergy,
+        "Energy of each deposit of a parameterized electron (at least 2 keV).");
+}
+
+
+FastElectronModel::~FastElectronModel()
+{
+    delete msg_;
+}
+
+
+void FastElectronModel::SetSegmentEnergy(G4double energy)
+{
+    if (energy < 2.*keV)
+    {
+        G4Exception("FastElectronModel::SetSegmentEnergy", "Warning", JustWarning,
+                    "The segment energy must be at least 2 keV; the command is ignored.");
+        return;
+    }
+
+    segment_energy_ = energy;
+}
+
+
+G4bool FastElectronModel::IsApplicable(G4ParticleDefinition const & particle)
+{
+    return &particle == G4Electron::Definition();
+}
+
+
+G4bool FastElectronModel::ModelTrigger(G4FastTrack const & fast_track)
+{
+    G4Track const * track = fast_track.GetPrimaryTrack();
+
+    G4double const kinetic_energy = track->GetKineticEnergy();
+    if (kinetic_energy <= 0. || kinetic_energy >= max_energy_) return false;
+
+    // the whole range must be inside the envelope
+    G4double const range = Range(kinetic_energy, track->GetMaterial()->GetDensity());
+    G4double const distance = fast_track.GetEnvelopeSolid()->DistanceToOut(
+        fast_track.GetPrimaryTrackLocalPosition(), fast_track.GetPrimaryTrackLocalDirection());
+
+    return range < distance;
+}
+
+
+void FastElectronModel::DoIt(G4FastTrack const & fast_track, G4FastStep & fast_step)
+{
+    G4Track * track = const_cast< G4Track * >(fast_track.GetPrimaryTrack());
+
+    G4double const kinetic_energy = track->GetKineticEnergy();
+    G4double const density = track->GetMaterial()->GetDensity();
+    G4ThreeVector const direction = track->GetMomentumDirection();
+
+    int const number_segments = std::max(1, int(std::ceil(kinetic_energy / segment_energy_)));
+    G4double const energy = kinetic_energy / number_segments;
+
+    // every deposit is handed to the sensitive detector as a step of the
+    // electron; the process is the one that invoked the model
+    G4Step step;
+    step.SetTrack(track);
+    G4StepPoint * pre_step_point = step.GetPreStepPoint();
+    G4StepPoint * post_step_point = step.GetPostStepPoint();
+    post_step_point->SetProcessDefinedStep(track->GetStep()->GetPostStepPoint()->GetProcessDefinedStep());
+    pre_step_point->SetWeight(track->GetWeight());
+    post_step_point->SetWeight(track->GetWeight());
+
+    G4ThreeVector position = track->GetPosition();
+    G4double time = track->GetGlobalTime();
+    G4double path_length = 0.;
+
+    for (int segment = 0; segment < number_segments; ++segment)
+    {
+        G4double const energy_before = kinetic_energy - segment * energy;
+        G4double const energy_after = segment + 1 < number_segments ? energy_before - energy : 0.;
+
+        G4double const length = Range(energy_before, density) - Range(energy_after, density);
+
+        // time of flight at the mean energy of the segment
+        G4double const gamma = 1. + 0.5 * (energy_before + energy_after) / electron_mass_c2;
+        G4double const beta = std::sqrt(1. - 1. / (gamma * gamma));
+
+        pre_step_point->SetPosition(position);
+        pre_step_point->SetGlobalTime(time);
+
+        position += length * direction;
+        time += length / (beta * c_light);
+        path_length += length;
+
+        post_step_point->SetPosition(position);
+        post_step_point->SetGlobalTime(time);
+
+        step.SetStepLength(length);
+        step.SetTotalEnergyDeposit(energy);
+
+        sensitive_detector_->Hit(&step);
+    }
+
+    fast_step.KillPrimaryTrack();
+    fast_step.ProposePrimaryTrackPathLength(path_length);
+    fast_step.ProposePrimaryTrackFinalPosition(position, false);
+    fast_step.ProposePrimaryTrackFinalTime(time);
+    fast_step.ProposeTotalEnergyDeposited(kinetic_energy);
+
+    // the target is the sensitive volume, and the deposits above are its
+    // hits already; the fast step itself must not be counted again
+    fast_step.ProposeSteppingControl(AvoidHitInvocation);
+}
+
+
+G4double FastElectronModel::Range(G4double kinetic_energy, G4double density)
+{
+    if (kinetic_energy <= 0.) return 0.;
+
+    // Katz-Penfold range-energy relation, R [g/cm2] for T [MeV]
+    G4double const T = kinetic_energy / MeV;
+    G4double const R = 0.412 * std::pow(T, 1.265 - 0.0954 * std::log(T));
+
+    return R * (g/cm2) / density;
+}
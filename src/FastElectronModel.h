@@ -0,0 +1,56 @@
+// -----------------------------------------------------------------------------
+//  G4_QPIX | FastElectronModel.h
+//
+//  Parameterized energy deposition of low-energy electrons in the target.
+//   * Author: Everybody is an author!
+//   * Creation date: 16 Oct 2026
+// -----------------------------------------------------------------------------
+
+#ifndef FAST_ELECTRON_MODEL_H
+#define FAST_ELECTRON_MODEL_H
+
+#include <G4VFastSimulationModel.hh>
+
+
+class G4GenericMessenger;
+class G4VSensitiveDetector;
+
+// Electrons below a kinetic energy threshold whose range is contained in the
+// envelope are not tracked. Their energy is laid down along a straight line
+// in the direction of motion, in deposits of equal energy whose lengths
+// follow the continuous-slowing-down range, and each deposit goes through
+// the sensitive detector as a step of the electron.
+class FastElectronModel: public G4VFastSimulationModel
+{
+    public:
+
+        FastElectronModel(G4String const &, G4Region *, G4VSensitiveDetector *);
+        virtual ~FastElectronModel();
+
+        virtual G4bool IsApplicable(G4ParticleDefinition const &);
+        virtual G4bool ModelTrigger(G4FastTrack const &);
+        virtual void DoIt(G4FastTrack const &, G4FastStep &);
+
+        // energy of each deposit along the range; at least 2 keV, so that
+        // every deposit, which is more than half of it, passes the 1 keV cut
+        // of the sensitive detector
+        void SetSegmentEnergy(G4double);
+
+    private:
+
+        // CSDA range of an electron of the given kinetic energy in a material
+        // of the given density
+        static G4double Range(G4double kinetic_energy, G4double density);
+
+        G4GenericMessenger* msg_; // Messenger for configuration parameters
+
+        G4VSensitiveDetector * sensitive_detector_;
+
+        // electrons below this kinetic energy are parameterized; 0 for none
+        G4double max_energy_;
+
+        // energy of each deposit along the range
+        G4double segment_energy_;
+};
+
+#endif
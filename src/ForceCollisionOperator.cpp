@@ -0,0 +1,95 @@
+// -----------------------------------------------------------------------------
+//  ForceCollisionOperator.cpp
+//
+//  Class definition of the forced collision biasing operator
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#include "ForceCollisionOperator.h"
+
+// GEANT4 includes
+#include "G4BOptrForceCollision.hh"
+#include "G4Exception.hh"
+#include "G4ParticleTable.hh"
+#include "G4Track.hh"
+
+//-----------------------------------------------------------------------------
+ForceCollisionOperator::ForceCollisionOperator(std::vector< G4String > const & particles)
+    : G4VBiasingOperator("ForceCollision"), current_operator_(nullptr)
+{
+    for (auto const & name : particles)
+    {
+        G4ParticleDefinition const * particle = G4ParticleTable::GetParticleTable()->FindParticle(name);
+        if (!particle)
+        {
+            G4Exception("ForceCollisionOperator::ForceCollisionOperator", "ForceCollision001", FatalException,
+                        ("unknown particle " + name).c_str());
+        }
+        // a particle given twice keeps its first operator
+        if (operators_.count(particle)) continue;
+        operators_[particle] = new G4BOptrForceCollision(particle, "ForceCollision_" + name);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void ForceCollisionOperator::StartTracking(G4Track const * track)
+{
+    // the G4BOptrForceCollision are in the list of all operators, so
+    // Geant4 starts and ends their tracks itself
+    auto const it = operators_.find(track->GetParticleDefinition());
+    current_operator_ = it != operators_.end() ? it->second : nullptr;
+}
+
+//-----------------------------------------------------------------------------
+G4VBiasingOperation * ForceCollisionOperator::ProposeNonPhysicsBiasingOperation(G4Track const * track,
+                                                                                G4BiasingProcessInterface const * process)
+{
+    if (!current_operator_) return nullptr;
+    return current_operator_->GetProposedNonPhysicsBiasingOperation(track, process);
+}
+
+//-----------------------------------------------------------------------------
+G4VBiasingOperation * ForceCollisionOperator::ProposeOccurenceBiasingOperation(G4Track const * track,
+                                                                               G4BiasingProcessInterface const * process)
+{
+    if (!current_operator_) return nullptr;
+    return current_operator_->GetProposedOccurenceBiasingOperation(track, process);
+}
+
+//-----------------------------------------------------------------------------
+G4VBiasingOperation * ForceCollisionOperator::ProposeFinalStateBiasingOperation(G4Track const * track,
+                                                                                G4BiasingProcessInterface const * process)
+{
+    if (!current_operator_) return nullptr;
+    return current_operator_->GetProposedFinalStateBiasingOperation(track, process);
+}
+
+//-----------------------------------------------------------------------------
+void ForceCollisionOperator::OperationApplied(G4BiasingProcessInterface const * process, G4BiasingAppliedCase biasing_case,
+                                              G4VBiasingOperation * operation, G4VParticleChange const * particle_change)
+{
+    if (current_operator_)
+    {
+        current_operator_->ReportOperationApplied(process, biasing_case, operation, particle_change);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void ForceCollisionOperator::OperationApplied(G4BiasingProcessInterface const * process, G4BiasingAppliedCase biasing_case,
+                                              G4VBiasingOperation * occurence_operation, G4double occurence_weight,
+                                              G4VBiasingOperation * final_state_operation,
+                                              G4VParticleChange const * particle_change)
+{
+    if (current_operator_)
+    {
+        current_operator_->ReportOperationApplied(process, biasing_case, occurence_operation, occurence_weight,
+                                                  final_state_operation, particle_change);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void ForceCollisionOperator::ExitBiasing(G4Track const * track, G4BiasingProcessInterface const * process)
+{
+    if (current_operator_) current_operator_->ExitingBiasing(track, process);
+}
@@ -0,0 +1,54 @@
+// -----------------------------------------------------------------------------
+//  ForceCollisionOperator.h
+//
+//  Class definition of the forced collision biasing operator
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#ifndef ForceCollisionOperator_h
+#define ForceCollisionOperator_h 1
+
+// GEANT4 includes
+#include "G4VBiasingOperator.hh"
+
+// C++ includes
+#include <map>
+#include <vector>
+
+class G4BOptrForceCollision;
+class G4ParticleDefinition;
+
+// Forced collision of several particle types in one volume. Geant4 only
+// attaches one biasing operator to a logical volume, so this operator is
+// the one attached to the target and hands each track to the
+// G4BOptrForceCollision of its particle type, as in the multi-particle
+// biasing examples (GB01).
+class ForceCollisionOperator : public G4VBiasingOperator {
+
+    public:
+
+        ForceCollisionOperator(std::vector< G4String > const & particles);
+
+        virtual void StartTracking(G4Track const *);
+
+    private:
+
+        virtual G4VBiasingOperation * ProposeNonPhysicsBiasingOperation(G4Track const *, G4BiasingProcessInterface const *);
+        virtual G4VBiasingOperation * ProposeOccurenceBiasingOperation(G4Track const *, G4BiasingProcessInterface const *);
+        virtual G4VBiasingOperation * ProposeFinalStateBiasingOperation(G4Track const *, G4BiasingProcessInterface const *);
+
+        virtual void OperationApplied(G4BiasingProcessInterface const *, G4BiasingAppliedCase,
+                                      G4VBiasingOperation *, G4VParticleChange const *);
+        virtual void OperationApplied(G4BiasingProcessInterface const *, G4BiasingAppliedCase,
+                                      G4VBiasingOperation *, G4double,
+                                      G4VBiasingOperation *, G4VParticleChange const *);
+        virtual void ExitBiasing(G4Track const *, G4BiasingProcessInterface const *);
+
+        std::map< G4ParticleDefinition const *, G4BOptrForceCollision * > operators_;
+
+        // operator of the particle type of the current track, or null
+        G4BOptrForceCollision * current_operator_;
+};
+
+#endif
@@ -0,0 +1,140 @@
+// -----------------------------------------------------------------------------
+//  HitBuffer.cpp
+//
+//  Class definition of the hit buffer
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#include "HitBuffer.h"
+
+// Q-Pix includes
+#include "ProcessRegistry.h"
+
+// GEANT4 includes
+#include "G4SystemOfUnits.hh"
+
+// C++ includes
+#include <numeric>
+
+//-----------------------------------------------------------------------------
+double HitBuffer::EnergyDeposit() const
+{
+    return std::accumulate(energy_deposit_.begin(), energy_deposit_.end(), 0.);
+}
+
+//-----------------------------------------------------------------------------
+void HitBuffer::Add(G4Step const * step)
+{
+    G4StepPoint const * pre_step_point = step->GetPreStepPoint();
+    G4StepPoint const * post_step_point = step->GetPostStepPoint();
+
+    track_id_.push_back(step->GetTrack()->GetTrackID());
+
+    start_x_.push_back(pre_step_point->GetPosition().x() / CLHEP::cm);
+    start_y_.push_back(pre_step_point->GetPosition().y() / CLHEP::cm);
+    start_z_.push_back(pre_step_point->GetPosition().z() / CLHEP::cm);
+    start_t_.push_back(pre_step_point->GetGlobalTime() / CLHEP::ns);
+
+    end_x_.push_back(post_step_point->GetPosition().x() / CLHEP::cm);
+    end_y_.push_back(post_step_point->GetPosition().y() / CLHEP::cm);
+    end_z_.push_back(post_step_point->GetPosition().z() / CLHEP::cm);
+    end_t_.push_back(post_step_point->GetGlobalTime() / CLHEP::ns);
+
+    length_.push_back(step->GetStepLength() / CLHEP::cm);
+    energy_deposit_.push_back(step->GetTotalEnergyDeposit() / CLHEP::MeV);
+
+    process_key_.push_back(ProcessRegistry::Instance()->Key(post_step_point->GetProcessDefinedStep()));
+
+    weight_.push_back(pre_step_point->GetWeight());
+}
+
+//-----------------------------------------------------------------------------
+bool HitBuffer::Extends(int const index, G4Step const * step,
+                        double const max_length, double const max_time) const
+{
+    // the step must start where the hit ends; a step dropped in between,
+    // e.g. below the energy threshold, breaks the segment
+    if (track_id_[index] != step->GetTrack()->GetTrackID()) return false;
+    if (end_t_[index] != step->GetPreStepPoint()->GetGlobalTime() / CLHEP::ns) return false;
+    if (weight_[index] != float(step->GetPreStepPoint()->GetWeight())) return false;
+
+    double const length = length_[index] + step->GetStepLength() / CLHEP::cm;
+    double const duration = step->GetPostStepPoint()->GetGlobalTime() / CLHEP::ns - start_t_[index];
+
+    if (max_length > 0. && length > max_length) return false;
+    if (max_time > 0. && duration > max_time) return false;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void HitBuffer::Extend(int const index, G4Step const * step)
+{
+    G4StepPoint const * post_step_point = step->GetPostStepPoint();
+
+    end_x_[index] = post_step_point->GetPosition().x() / CLHEP::cm;
+    end_y_[index] = post_step_point->GetPosition().y() / CLHEP::cm;
+    end_z_[index] = post_step_point->GetPosition().z() / CLHEP::cm;
+    end_t_[index] = post_step_point->GetGlobalTime() / CLHEP::ns;
+
+    length_[index] += step->GetStepLength() / CLHEP::cm;
+    energy_deposit_[index] += step->GetTotalEnergyDeposit() / CLHEP::MeV;
+
+    process_key_[index] = ProcessRegistry::Instance()->Key(post_step_point->GetProcessDefinedStep());
+}
+
+//-----------------------------------------------------------------------------
+void HitBuffer::Append(HitBuffer const & other, int const offset)
+{
+    for (auto const track_id : other.track_id_) track_id_.push_back(track_id + offset);
+
+    start_x_.insert(start_x_.end(), other.start_x_.begin(), other.start_x_.end());
+    start_y_.insert(start_y_.end(), other.start_y_.begin(), other.start_y_.end());
+    start_z_.insert(start_z_.end(), other.start_z_.begin(), other.start_z_.end());
+    start_t_.insert(start_t_.end(), other.start_t_.begin(), other.start_t_.end());
+    end_x_.insert(end_x_.end(), other.end_x_.begin(), other.end_x_.end());
+    end_y_.insert(end_y_.end(), other.end_y_.begin(), other.end_y_.end());
+    end_z_.insert(end_z_.end(), other.end_z_.begin(), other.end_z_.end());
+    end_t_.insert(end_t_.end(), other.end_t_.begin(), other.end_t_.end());
+    length_.insert(length_.end(), other.length_.begin(), other.length_.end());
+    energy_deposit_.insert(energy_deposit_.end(), other.energy_deposit_.begin(), other.energy_deposit_.end());
+    process_key_.insert(process_key_.end(), other.process_key_.begin(), other.process_key_.end());
+    weight_.insert(weight_.end(), other.weight_.begin(), other.weight_.end());
+}
+
+//-----------------------------------------------------------------------------
+void HitBuffer::Branch(TTree * tree)
+{
+    tree->Branch("hit_track_id",       &track_id_);
+    tree->Branch("hit_start_x",        &start_x_);
+    tree->Branch("hit_start_y",        &start_y_);
+    tree->Branch("hit_start_z",        &start_z_);
+    tree->Branch("hit_start_t",        &start_t_);
+    tree->Branch("hit_end_x",          &end_x_);
+    tree->Branch("hit_end_y",          &end_y_);
+    tree->Branch("hit_end_z",          &end_z_);
+    tree->Branch("hit_end_t",          &end_t_);
+    tree->Branch("hit_energy_deposit", &energy_deposit_);
+    tree->Branch("hit_length",         &length_);
+    tree->Branch("hit_process_key",    &process_key_);
+    tree->Branch("hit_weight",         &weight_);
+}
+
+//-----------------------------------------------------------------------------
+void HitBuffer::Clear()
+{
+    track_id_.clear();
+    start_x_.clear();
+    start_y_.clear();
+    start_z_.clear();
+    start_t_.clear();
+    end_x_.clear();
+    end_y_.clear();
+    end_z_.clear();
+    end_t_.clear();
+    length_.clear();
+    energy_deposit_.clear();
+    process_key_.clear();
+    weight_.clear();
+}
@@ -0,0 +1,80 @@
+// -----------------------------------------------------------------------------
+//  HitBuffer.h
+//
+//  Class definition of the hit buffer
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#ifndef HitBuffer_h
+#define HitBuffer_h 1
+
+// Q-Pix includes
+#include "geo_types.h"
+
+// GEANT4 includes
+#include "G4Step.hh"
+
+// ROOT includes
+#include "TTree.h"
+
+// C++ includes
+#include <vector>
+
+// hits of one event, stored column by column. The sensitive detector appends
+// to the buffer of the MC truth manager, which is swapped into the event
+// record at the end of the event, so the columns the event tree branches
+// are bound to are filled without a second copy.
+struct HitBuffer
+{
+    std::vector< int >          track_id_;
+    std::vector< Coordinate_t > start_x_;
+    std::vector< Coordinate_t > start_y_;
+    std::vector< Coordinate_t > start_z_;
+    std::vector< double >       start_t_;
+    std::vector< Coordinate_t > end_x_;
+    std::vector< Coordinate_t > end_y_;
+    std::vector< Coordinate_t > end_z_;
+    std::vector< double >       end_t_;
+    std::vector< Coordinate_t > length_;
+    std::vector< double >       energy_deposit_;
+    std::vector< int >          process_key_;
+
+    // statistical weight of the track at the start of the hit
+    std::vector< float >        weight_;
+
+    inline int Size() const { return track_id_.size(); }
+
+    // memory taken by the hits
+    inline size_t Bytes() const
+    {
+        return track_id_.size() * (2 * sizeof(int) + 7 * sizeof(Coordinate_t) + 3 * sizeof(double) + sizeof(float));
+    }
+
+    // energy deposited by the hits, in MeV
+    double EnergyDeposit() const;
+
+    // append a hit made from a step in the sensitive volume
+    void Add(G4Step const *);
+
+    // whether a step continues the given hit, and the segment made of both
+    // is no longer than the given length (cm) and duration (ns); a limit of
+    // 0 does not apply
+    bool Extends(int const, G4Step const *, double const, double const) const;
+
+    // merge a step into the given hit: the hit ends where the step ends and
+    // gets its energy, length and process
+    void Extend(int const, G4Step const *);
+
+    // append the hits of another buffer, with its track IDs moved up by the
+    // given offset
+    void Append(HitBuffer const &, int const);
+
+    // create the hit_* branches of the event tree, bound to this buffer
+    void Branch(TTree *);
+
+    // clear the hits, keeping the capacity
+    void Clear();
+};
+
+#endif
@@ -0,0 +1,111 @@
+// -----------------------------------------------------------------------------
+//  G4_QPIX | ImportanceWorld.cpp
+//
+//  Parallel world of the importance cells across the shield and wall layers.
+//   * Author: Everybody is an author!
+//   * Creation date: 16 Oct 2026
+// -----------------------------------------------------------------------------
+
+#include "ImportanceWorld.h"
+
+// Q-Pix includes
+#include "DetectorConstruction.h"
+
+// GEANT4 includes
+#include "G4GenericMessenger.hh"
+#include "G4IStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4Tubs.hh"
+
+// C++ includes
+#include <algorithm>
+#include <string>
+
+
+ImportanceWorld::ImportanceWorld(G4String const & name, DetectorConstruction const * detector):
+  G4VUserParallelWorld(name), detector_(detector), ratio_(2.), shells_(2)
+{
+    msg_ = new G4GenericMessenger(this, "/importance/", "Control commands of the importance biasing.");
+    msg_->DeclareProperty("ratio", ratio_, "Importance ratio between neighbouring cells, going inwards.");
+    msg_->DeclareProperty("shells", shells_, "Number of importance cells the shield and the wall are each cut into.");
+}
+
+
+ImportanceWorld::~ImportanceWorld()
+{
+    delete msg_;
+}
+
+
+void ImportanceWorld::Construct()
+{
+    G4VPhysicalVolume * ghost_world = GetWorld();
+    G4LogicalVolume * ghost_world_logic = ghost_world->GetLogicalVolume();
+
+    // the cells follow the placed volumes, so their boundaries coincide
+    G4Tubs const * target = static_cast< G4Tubs const * >(detector_->GetLogicTarget()->GetSolid());
+    G4Tubs const * shield = static_cast< G4Tubs const * >(detector_->GetLogicShield()->GetSolid());
+    G4Tubs const * vacuum = static_cast< G4Tubs const * >(detector_->GetLogicVacuum()->GetSolid());
+    G4Tubs const * wall = static_cast< G4Tubs const * >(detector_->GetLogicWall()->GetSolid());
+
+    // radial bounds and half length of the cells, from the outside in
+    struct Bounds { G4double inner, outer, half_length; };
+    std::vector< Bounds > bounds;
+
+    int const shells = std::max(shells_, 1);
+    auto const split = [&bounds, shells] (G4Tubs const * solid)
+    {
+        G4double const inner = solid->GetInnerRadius();
+        G4double const thickness = (solid->GetOuterRadius() - inner) / shells;
+        for (int shell = shells; shell > 0; --shell)
+        {
+            bounds.push_back({ inner + (shell - 1) * thickness, inner + shell * thickness, solid->GetZHalfLength() });
+        }
+    };
+
+    split(wall);
+    bounds.push_back({ vacuum->GetInnerRadius(), vacuum->GetOuterRadius(), vacuum->GetZHalfLength() });
+    split(shield);
+    bounds.push_back({ 0., target->GetOuterRadius(), target->GetZHalfLength() });
+
+    G4Tubs const * world_solid = static_cast< G4Tubs const * >(ghost_world_logic->GetSolid());
+
+    cells_.clear();
+    for (auto const & bound : bounds)
+    {
+        G4String const name = "ImportanceCell_" + std::to_string(cells_.size());
+
+        // an empty cell, or one sticking out of the world, would leave a
+        // layer without its importance
+        if (bound.outer <= bound.inner || bound.half_length <= 0. ||
+            bound.outer > world_solid->GetOuterRadius() || bound.half_length > world_solid->GetZHalfLength())
+        {
+            G4Exception("ImportanceWorld::Construct()", "[importance]", FatalException,
+                        (name + " is empty or outside the world").c_str());
+        }
+
+        G4Tubs * solid = new G4Tubs(name, bound.inner, bound.outer, bound.half_length, 0., twopi);
+        G4LogicalVolume * logic = new G4LogicalVolume(solid, 0, name);
+
+        cells_.push_back(new G4PVPlacement(0, G4ThreeVector(), logic, name, ghost_world_logic, false, 0));
+    }
+}
+
+
+void ImportanceWorld::ConstructSD()
+{
+    // every thread fills its own importance store
+    G4IStore * store = G4IStore::GetInstance(GetName());
+    store->Clear();
+
+    store->AddImportanceGeometryCell(1., *GetWorld());
+
+    G4double importance = 1.;
+    for (auto const cell : cells_)
+    {
+        importance *= ratio_;
+        store->AddImportanceGeometryCell(importance, *cell);
+    }
+}
@@ -0,0 +1,51 @@
+// -----------------------------------------------------------------------------
+//  G4_QPIX | ImportanceWorld.h
+//
+//  Parallel world of the importance cells across the shield and wall layers.
+//   * Author: Everybody is an author!
+//   * Creation date: 16 Oct 2026
+// -----------------------------------------------------------------------------
+
+#ifndef IMPORTANCE_WORLD_H
+#define IMPORTANCE_WORLD_H
+
+#include <G4VUserParallelWorld.hh>
+
+#include <vector>
+
+
+class DetectorConstruction;
+class G4GenericMessenger;
+
+// Concentric shells that follow the layers of the detector: the wall and the
+// shield are each cut into a number of shells, the vacuum is one shell and
+// the target one cell. The importance grows by a constant ratio from one
+// cell to the next going inwards, so particles are split on their way in
+// and played Russian roulette on their way out.
+class ImportanceWorld: public G4VUserParallelWorld
+{
+    public:
+
+        ImportanceWorld(G4String const &, DetectorConstruction const *);
+        virtual ~ImportanceWorld();
+
+        virtual void Construct();
+        virtual void ConstructSD();
+
+    private:
+
+        G4GenericMessenger* msg_; // Messenger for configuration parameters
+
+        DetectorConstruction const * detector_;
+
+        // importance ratio between neighbouring cells
+        double ratio_;
+
+        // number of shells the shield and the wall are each cut into
+        int shells_;
+
+        // cells from the outside in; their importances are ratio^1, ratio^2...
+        std::vector< G4VPhysicalVolume * > cells_;
+};
+
+#endif
@@ -8,17 +8,6 @@
 
 #include "MCParticle.h"
 
-// GEANT4 includes
-#include "G4VProcess.hh"
-
-//-----------------------------------------------------------------------------
-MCParticle::MCParticle()
-{}
-
-//-----------------------------------------------------------------------------
-MCParticle::~MCParticle()
-{}
-
 //-----------------------------------------------------------------------------
 // void MCParticle::AddTrajectoryPoint(const TrajectoryPoint & point)
 // {
@@ -26,41 +15,28 @@ MCParticle::~MCParticle()
 // }
 
 //-----------------------------------------------------------------------------
-void MCParticle::AddTrajectoryHit(const TrajectoryHit & hit)
+void MCParticle::AddHit(int const index, double const energy)
 {
-    hits_.push_back(hit);
+    if (number_hits_ == 0) first_hit_ = index;
+    number_hits_++;
+
+    energy_deposited_ += energy;
 }
 
 //-----------------------------------------------------------------------------
-void MCParticle::AddTrajectoryHit(const G4Step * step)
+void MCParticle::SetInitialPosition(double const x, double const y, double const z, double const t)
 {
-    // initialize hit
-    TrajectoryHit hit;
-    hit.start_ = { step->GetPreStepPoint()->GetPosition().x()/CLHEP::cm,
-                   step->GetPreStepPoint()->GetPosition().y()/CLHEP::cm,
-                   step->GetPreStepPoint()->GetPosition().z()/CLHEP::cm, };
-    hit.end_   = { step->GetPostStepPoint()->GetPosition().x()/CLHEP::cm,
-                   step->GetPostStepPoint()->GetPosition().y()/CLHEP::cm,
-                   step->GetPostStepPoint()->GetPosition().z()/CLHEP::cm, };
-    hit.energy_deposit_ = step->GetTotalEnergyDeposit() / CLHEP::MeV;
-    hit.start_time_ = step->GetPreStepPoint()->GetGlobalTime() / CLHEP::ns;
-    hit.end_time_   = step->GetPostStepPoint()->GetGlobalTime() / CLHEP::ns;
-    hit.track_id_   = step->GetTrack()->GetTrackID();
-    hit.pdg_code_   = step->GetTrack()->GetParticleDefinition()->GetPDGEncoding();
-    hit.length_     = step->GetStepLength() / CLHEP::cm;
-    hit.process_    = step->GetPostStepPoint()->GetProcessDefinedStep()->GetProcessName();
-
-    energy_deposited_ += step->GetTotalEnergyDeposit() / CLHEP::MeV;
-
-    // add hit
-    this->AddTrajectoryHit(hit);
+    initial_x_ = x;
+    initial_y_ = y;
+    initial_z_ = z;
+    initial_t_ = t;
 }
 
 //-----------------------------------------------------------------------------
-void MCParticle::AddDaughter(int const trackID)
+void MCParticle::SetInitialMomentum(double const px, double const py, double const pz, double const energy)
 {
-    // add daughter track ID and increment counter
-    daughter_track_ids_.push_back(trackID);
-    number_daughters_++;
+    initial_px_ = px;
+    initial_py_ = py;
+    initial_pz_ = pz;
+    initial_energy_ = energy;
 }
-
@@ -12,18 +12,9 @@
 // Q-Pix includes
 #include "geo_types.h"
 
-// GEANT4 includes
-#include "G4LorentzVector.hh"
-#include "G4Step.hh"
-
-// ROOT includes
-#include "TLorentzVector.h"
-
 // C++ includes
-#include <string>
-#include <tuple>
-#include <utility>
-#include <vector>
+#include <cstdint>
+#include <type_traits>
 
 // struct TrajectoryPoint
 // {
@@ -50,51 +41,37 @@
 //     double E()  const { return momentum_.E();  }
 // };
 
-struct TrajectoryHit
-{
-    Point_t     start_ = {0., 0., 0.};
-    Point_t     end_ = {0., 0., 0.};
-    double      energy_deposit_ = 0;
-    double      start_time_ = 0;
-    double      end_time_ = 0;
-    int         track_id_ = -1;
-    int         pdg_code_ = -1;
-    double      length_ = 0;
-    std::string process_ = "unknown";
-
-    Point_t StartPoint()  const { return start_; }
-    Point_t EndPoint()    const { return end_;   }
-    Point_t MidPoint()    const { return { (start_.X() + end_.X())/2.0,
-                                           (start_.Y() + end_.Y())/2.0,
-                                           (start_.Z() + end_.Z())/2.0 }; }
-    double  StartTime()   const { return start_time_;     }
-    double  EndTime()     const { return end_time_;       }
-    double  Time()        const { return (start_time_ + end_time_)/2.0; }
-    double  Energy()      const { return energy_deposit_; }
-    double  TrackID()     const { return track_id_;       }
-    double  PDGCode()     const { return pdg_code_;       }
-    double  Length()      const { return length_;         }
-    std::string Process() const { return process_; }
-};
-
+// Plain record of one particle of the event. It is trivially destructible,
+// so the MC truth manager releases the event arena without visiting the
+// particles, and its members are ordered by size to avoid padding. The
+// daughter track IDs are not stored: they follow from the parent track IDs.
 class MCParticle
 {
 
     public:
 
-        MCParticle();
-        ~MCParticle();
-
         // void AddTrajectoryPoint(const TrajectoryPoint &);
-        void AddTrajectoryHit(TrajectoryHit const &);
-        void AddTrajectoryHit(G4Step const *);
 
-        void AddDaughter(int const);
+        // account for a hit stored at the given index of the event hit
+        // buffer; Geant4 tracks one track to the end before starting the
+        // next, so the hits of a particle are contiguous in the buffer
+        void AddHit(int const, double const);
 
-        inline std::vector< TrajectoryHit > Hits() const { return hits_; }
+        // account for a step merged into the last hit of the particle
+        inline void AddEnergyDeposit(double const energy) { energy_deposited_ += energy; }
 
-        inline int          NumberDaughters() const { return number_daughters_; }
-        inline std::vector< int > Daughters() const { return daughter_track_ids_; }
+        inline void AddDaughter() { number_daughters_++; }
+
+        // tracks of the particle's subtree that are not finished yet, the
+        // particle itself included; the particle is closed once it is 0
+        inline int  OpenTracks() const { return open_tracks_; }
+        inline bool Closed()     const { return open_tracks_ == 0; }
+        inline void AddOpenTracks(int const number) { open_tracks_ += number; }
+        inline void Close() { open_tracks_ = 0; }
+
+        inline int FirstHit()        const { return first_hit_;        }
+        inline int NumberHits()      const { return number_hits_;      }
+        inline int NumberDaughters() const { return number_daughters_; }
 
         inline int         TrackID()        const { return track_id_;        }
         inline int         ParentTrackID()  const { return parent_track_id_; }
@@ -102,13 +79,20 @@ class MCParticle
         inline double      Mass()           const { return mass_;            }
         inline double      Charge()         const { return charge_;          }
         inline double      GlobalTime()     const { return global_time_;     }
-        inline std::string Process()        const { return process_;         }
+        inline int         ProcessKey()     const { return process_key_;     }
         inline int         TotalOccupancy() const { return total_occupancy_; }
+        inline double      Weight()         const { return weight_;          }
 
         inline double EnergyDeposited() const { return energy_deposited_; }
 
-        inline TLorentzVector InitialPosition() const { return initial_position_; }
-        inline TLorentzVector InitialMomentum() const { return initial_momentum_; }
+        inline Coordinate_t InitialX()      const { return initial_x_;      }
+        inline Coordinate_t InitialY()      const { return initial_y_;      }
+        inline Coordinate_t InitialZ()      const { return initial_z_;      }
+        inline double       InitialT()      const { return initial_t_;      }
+        inline Coordinate_t InitialPx()     const { return initial_px_;     }
+        inline Coordinate_t InitialPy()     const { return initial_py_;     }
+        inline Coordinate_t InitialPz()     const { return initial_pz_;     }
+        inline double       InitialEnergy() const { return initial_energy_; }
 
         inline void SetTrackID(int const trackID)               { track_id_ = trackID;               }
         inline void SetParentTrackID(int const parentTrackID)   { parent_track_id_ = parentTrackID;  }
@@ -116,35 +100,50 @@ class MCParticle
         inline void SetMass(double const mass)                  { mass_ = mass;                      }
         inline void SetCharge(double const charge)              { charge_ = charge;                  }
         inline void SetGlobalTime(double const globalTime)      { global_time_ = globalTime;         }
-        inline void SetProcess(std::string const process)       { process_ = process;                }
+        inline void SetProcessKey(int const processKey)         { process_key_ = processKey;         }
         inline void SetTotalOccupancy(int const totalOccupancy) { total_occupancy_ = totalOccupancy; }
+        inline void SetWeight(double const weight)              { weight_ = weight;                  }
 
-        inline void SetInitialPosition(TLorentzVector const initialPosition) { initial_position_ = initialPosition; }
-        inline void SetInitialMomentum(TLorentzVector const initialMomentum) { initial_momentum_ = initialMomentum; }
+        void SetInitialPosition(double const, double const, double const, double const);
+        void SetInitialMomentum(double const, double const, double const, double const);
 
     private:
 
-        int         track_id_;
-        int         parent_track_id_;
-        int         pdg_code_;
-        double      mass_;
-        double      charge_;
-        double      global_time_;
-        std::string process_;
-        int         total_occupancy_;
+        double       global_time_ = 0;
+        double       initial_t_ = 0;
+        double       energy_deposited_ = 0;
+        double       mass_ = 0;
+        double       initial_energy_ = 0;
+
+        Coordinate_t initial_x_ = 0;
+        Coordinate_t initial_y_ = 0;
+        Coordinate_t initial_z_ = 0;
+        Coordinate_t initial_px_ = 0;
+        Coordinate_t initial_py_ = 0;
+        Coordinate_t initial_pz_ = 0;
 
-        double      energy_deposited_ = 0.;
+        float        charge_ = 0;
 
-        TLorentzVector initial_position_;
-        TLorentzVector initial_momentum_;
+        // statistical weight of the track when it was created; 1 unless
+        // the run is biased
+        float        weight_ = 1;
 
-        // std::vector< TrajectoryPoint > trajectory_;
-        std::vector< TrajectoryHit > hits_;
+        int32_t      track_id_ = -1;
+        int32_t      parent_track_id_ = -1;
+        int32_t      pdg_code_ = 0;
+        int32_t      process_key_ = -1;
+        int32_t      total_occupancy_ = 0;
 
-        int                number_daughters_ = 0;
-        std::vector< int > daughter_track_ids_;
+        // range of the hits in the event hit buffer
+        int32_t      first_hit_ = 0;
+        int32_t      number_hits_ = 0;
+
+        int32_t      number_daughters_ = 0;
+        int32_t      open_tracks_ = 1;
 
 };
 
-#endif
+static_assert(std::is_trivially_destructible< MCParticle >::value,
+              "MC particles are released with the event arena without being destroyed");
 
+#endif
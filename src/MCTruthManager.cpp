@@ -8,15 +8,27 @@
 
 #include "MCTruthManager.h"
 
-MCTruthManager * MCTruthManager::instance_ = 0;
+// C++ includes
+#include <algorithm>
+
+G4ThreadLocal MCTruthManager * MCTruthManager::instance_ = 0;
 
 //-----------------------------------------------------------------------------
 MCTruthManager::MCTruthManager()
-{}
+  : run_(-1), event_(-1), sub_event_(0), number_sub_events_(1),
+    first_track_id_(0), lowest_pending_primary_(1), number_live_particles_(0), number_closed_particles_(0),
+    memory_limit_(0)
+{
+    arena_buffer_.resize(1 << 20);
+    arena_ = std::make_unique< std::pmr::monotonic_buffer_resource >(
+        arena_buffer_.data(), arena_buffer_.size(), &arena_upstream_);
+}
 
 //-----------------------------------------------------------------------------
 MCTruthManager::~MCTruthManager()
-{}
+{
+    this->EventReset();
+}
 
 //-----------------------------------------------------------------------------
 MCTruthManager * MCTruthManager::Instance()
@@ -28,14 +40,34 @@ MCTruthManager * MCTruthManager::Instance()
 //-----------------------------------------------------------------------------
 void MCTruthManager::EventReset()
 {
-    // delete pointers in MC particle map
-    for (auto p : mc_particle_map_)
+    // clear MC particle store, hits and voxels, keeping their capacity for
+    // the next event
+    mc_particles_.clear();
+    keep_.clear();
+    free_particles_.clear();
+    pending_primaries_.clear();
+    hits_.Clear();
+    voxels_.Clear();
+
+    first_track_id_ = 0;
+    lowest_pending_primary_ = 1;
+    number_live_particles_ = 0;
+    number_closed_particles_ = 0;
+
+    // release the arena in one go; if the event overflowed the buffer, grow
+    // the buffer by the overflow so that the next such event fits
+    if (arena_upstream_.Bytes() > 0)
     {
-        delete p.second;
+        arena_.reset();
+        arena_buffer_.resize(arena_buffer_.size() + arena_upstream_.Bytes());
+        arena_upstream_.Reset();
+        arena_ = std::make_unique< std::pmr::monotonic_buffer_resource >(
+            arena_buffer_.data(), arena_buffer_.size(), &arena_upstream_);
+    }
+    else
+    {
+        arena_->release();
     }
-
-    // clear MC particle map container
-    mc_particle_map_.clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -50,16 +82,91 @@ void MCTruthManager::SetEvent(int const value)
     event_ = value;
 }
 
+//-----------------------------------------------------------------------------
+void MCTruthManager::SetSubEvent(int const index, int const number)
+{
+    sub_event_ = index;
+    number_sub_events_ = number;
+}
+
+//-----------------------------------------------------------------------------
+void MCTruthManager::SetNumberPrimaries(int const number)
+{
+    pending_primaries_.assign(number, 1);
+    lowest_pending_primary_ = 1;
+}
+
+//-----------------------------------------------------------------------------
+void MCTruthManager::PrimaryDone(int const trackID)
+{
+    if (trackID < 1 || static_cast< size_t >(trackID) > pending_primaries_.size()) return;
+
+    pending_primaries_[trackID - 1] = 0;
+
+    while (static_cast< size_t >(lowest_pending_primary_) <= pending_primaries_.size() &&
+           !pending_primaries_[lowest_pending_primary_ - 1])
+    {
+        lowest_pending_primary_ += 1;
+    }
+}
+
+//-----------------------------------------------------------------------------
+MCParticle * MCTruthManager::NewMCParticle()
+{
+    void * memory = 0;
+
+    if (free_particles_.empty())
+    {
+        memory = arena_->allocate(sizeof(MCParticle), alignof(MCParticle));
+    }
+    else
+    {
+        memory = free_particles_.back();
+        free_particles_.pop_back();
+    }
+
+    number_live_particles_ += 1;
+
+    return new (memory) MCParticle();
+}
+
 //-----------------------------------------------------------------------------
 void MCTruthManager::AddMCParticle(MCParticle * particle)
 {
-    mc_particle_map_[particle->TrackID()] = particle;
+    if (particle->TrackID() < first_track_id_)
+    {
+        std::string message = "\nTrack ID " + std::to_string(particle->TrackID())
+                            + " is below the first slot of the store, "
+                            + std::to_string(first_track_id_) + "\n";
+        G4Exception("MCTruthManager::AddMCParticle", "Error",
+                    FatalException, message.data());
+    }
+
+    this->PrimaryDone(particle->TrackID());
+
+    size_t const index = particle->TrackID() - first_track_id_;
+    if (index >= mc_particles_.size())
+    {
+        mc_particles_.resize(index + 1, nullptr);
+        keep_.resize(index + 1, 0);
+    }
+    mc_particles_[index] = particle;
+}
+
+//-----------------------------------------------------------------------------
+MCParticle * MCTruthManager::Slot(int const trackID) const
+{
+    size_t const index = trackID - first_track_id_;
+    if (trackID < first_track_id_ || index >= mc_particles_.size()) return nullptr;
+    return mc_particles_[index];
 }
 
 //-----------------------------------------------------------------------------
 MCParticle * MCTruthManager::GetMCParticle(int const trackID)
 {
-    if (mc_particle_map_.count(trackID) < 1)
+    MCParticle * particle = this->Slot(trackID);
+
+    if (!particle)
     {
         std::string message = "\nLine "
                             + std::to_string(__LINE__)
@@ -71,6 +178,126 @@ MCParticle * MCTruthManager::GetMCParticle(int const trackID)
         G4Exception("MCTruthManager::MCTruthManager", "Error",
                     FatalException, message.data());
     }
-    return mc_particle_map_.at(trackID);
+    return particle;
 }
 
+//-----------------------------------------------------------------------------
+void MCTruthManager::Release(size_t const index)
+{
+    free_particles_.push_back(mc_particles_[index]);
+    mc_particles_[index] = nullptr;
+    number_live_particles_ -= 1;
+    number_closed_particles_ -= 1;
+}
+
+//-----------------------------------------------------------------------------
+void MCTruthManager::Prune(std::vector< int > const & keep_pdg_codes)
+{
+    // daughters have higher track IDs than their parents, so one pass from
+    // the highest track ID down has marked every descendant of a particle
+    // by the time it is reached. A particle that is still open may get
+    // more descendants, and is decided once it is closed.
+    for (size_t index = mc_particles_.size(); index-- > 0; )
+    {
+        MCParticle const * particle = mc_particles_[index];
+        if (!particle || !particle->Closed()) continue;
+
+        if (!keep_[index])
+        {
+            keep_[index] = particle->EnergyDeposited() > 0. ||
+                std::find(keep_pdg_codes.begin(), keep_pdg_codes.end(),
+                          particle->PDGCode()) != keep_pdg_codes.end();
+        }
+
+        if (!keep_[index])
+        {
+            this->Release(index);
+            continue;
+        }
+
+        int const parentTrackID = particle->ParentTrackID();
+        if (parentTrackID >= first_track_id_ && parentTrackID > 0) keep_[parentTrackID - first_track_id_] = 1;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void MCTruthManager::EndTrack(int const trackID, int const numberSecondaries)
+{
+    MCParticle * particle = this->GetMCParticle(trackID);
+
+    // the secondaries are now open, the track itself is done
+    particle->AddOpenTracks(numberSecondaries - 1);
+
+    this->CloseAncestors(particle);
+}
+
+//-----------------------------------------------------------------------------
+void MCTruthManager::DropTrack(int const trackID, int const parentTrackID)
+{
+    this->PrimaryDone(trackID);
+
+    MCParticle * particle = this->Slot(parentTrackID);
+    if (!particle) return;
+
+    particle->AddOpenTracks(-1);
+
+    this->CloseAncestors(particle);
+}
+
+//-----------------------------------------------------------------------------
+void MCTruthManager::CloseAncestors(MCParticle * particle)
+{
+    // a closed particle closes its parent if it was the last open track
+    // below it
+    while (particle && particle->Closed())
+    {
+        number_closed_particles_ += 1;
+        particle = this->Slot(particle->ParentTrackID());
+        if (particle) particle->AddOpenTracks(-1);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void MCTruthManager::CloseAll()
+{
+    for (auto particle : mc_particles_)
+    {
+        if (particle && !particle->Closed())
+        {
+            particle->Close();
+            number_closed_particles_ += 1;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void MCTruthManager::ReleaseClosed()
+{
+    for (size_t index = 0; index < mc_particles_.size(); ++index)
+    {
+        if (mc_particles_[index] && mc_particles_[index]->Closed()) this->Release(index);
+    }
+
+    // drop the empty slots in front of the first open particle, but not
+    // those of primaries still to come
+    size_t last = mc_particles_.size();
+    if (static_cast< size_t >(lowest_pending_primary_) <= pending_primaries_.size())
+    {
+        last = std::min(last, static_cast< size_t >(lowest_pending_primary_ - first_track_id_));
+    }
+
+    size_t first = 0;
+    while (first < last && !mc_particles_[first]) ++first;
+
+    mc_particles_.erase(mc_particles_.begin(), mc_particles_.begin() + first);
+    keep_.erase(keep_.begin(), keep_.begin() + first);
+    first_track_id_ += first;
+}
+
+//-----------------------------------------------------------------------------
+size_t MCTruthManager::FreeableMemory() const
+{
+    return number_closed_particles_ * sizeof(MCParticle)
+         + hits_.Bytes()
+         + voxels_.Bytes();
+}
@@ -11,7 +11,9 @@
 
 // Q-Pix includes
 #include "GeneratorParticle.h"
+#include "HitBuffer.h"
 #include "MCParticle.h"
+#include "VoxelBuffer.h"
 
 // GEANT4 includes
 #include "globals.hh"
@@ -23,8 +25,12 @@
 #include "TBranch.h"
 
 // C++ includes
+#include <cstddef>
 #include <map>
+#include <memory>
+#include <memory_resource>
 #include <set>
+#include <vector>
 
 class MCTruthManager {
 
@@ -37,24 +43,155 @@ class MCTruthManager {
 
         void SetRun(int const);
         void SetEvent(int const);
+        void SetSubEvent(int const, int const);
+
+        // number of primary tracks of the event, numbered from 1; their
+        // slots are kept until they are tracked or dropped
+        void SetNumberPrimaries(int const);
+
+        inline int Event()           const { return event_;             }
+        inline int SubEvent()        const { return sub_event_;         }
+        inline int NumberSubEvents() const { return number_sub_events_; }
 
         static MCTruthManager* Instance();
 
+        // create an MC particle in the event arena; it is owned by the MC
+        // truth manager and released with the whole arena at EventReset,
+        // or earlier by Prune and ReleaseClosed for reuse within the event
+        MCParticle * NewMCParticle();
+
         void AddMCParticle(MCParticle *);
         MCParticle * GetMCParticle(int const);
 
-        inline std::map< int, MCParticle * > GetMCParticleMap() const { return mc_particle_map_; }
+        // drop the closed MC particles that deposited no energy, unless
+        // their PDG code is in the given list or one of their descendants is
+        // kept; the kept particles form closed chains up to their primaries
+        void Prune(std::vector< int > const &);
+
+        // a track has finished, leaving the given number of secondaries on
+        // the stack; closes the particle, and its ancestors, once all its
+        // descendants have finished too
+        void EndTrack(int const, int const);
+
+        // a track, with the given parent track ID, will never be tracked
+        void DropTrack(int const, int const);
+
+        // close every particle, at the end of the event
+        void CloseAll();
+
+        // release the closed MC particles, once they have been written
+        void ReleaseClosed();
+
+        // MC particles in track ID order, indexed by track ID minus the
+        // track ID of the first slot; slots of track IDs that were never
+        // tracked, or were released, hold a null pointer
+        inline std::vector< MCParticle * > const & GetMCParticles() const { return mc_particles_; }
+
+        // bound on the memory of the truth of the event, in bytes (0: none)
+        inline void SetMemoryLimit(size_t const bytes) { memory_limit_ = bytes; }
+
+        // memory that writing a chunk frees: the closed MC particles, the
+        // hits and the voxels. The slots of the store, which are kept up to
+        // the lowest primary still to come, are not counted, or they would
+        // keep the limit reached for the rest of the event. A chunk empties
+        // this memory, so the next chunk is only due once it has grown past
+        // the limit again.
+        size_t FreeableMemory() const;
+        inline bool MemoryLimitReached() const
+        {
+            return memory_limit_ > 0 && number_closed_particles_ > 0 && this->FreeableMemory() > memory_limit_;
+        }
+
+        // hits of the event, in the order they were made
+        inline HitBuffer & GetHits() { return hits_; }
+
+        // energy deposits of the event in voxel mode
+        inline VoxelBuffer & GetVoxels() { return voxels_; }
 
     private:
 
-        static MCTruthManager * instance_;
+        // one instance per worker thread
+        static G4ThreadLocal MCTruthManager * instance_;
 
         int run_;
         int event_;
 
-        // MC particle map
-        // std::map< int, MCParticle > mc_particle_map_;
-        std::map< int, MCParticle * > mc_particle_map_;
+        // sub-event index and number of sub-events of the current event
+        int sub_event_;
+        int number_sub_events_;
+
+        // MC particle store; Geant4 track IDs are dense, so a vector indexed
+        // by track ID replaces a map and keeps the track ID ordering
+        std::vector< MCParticle * > mc_particles_;
+
+        // track ID of the first slot of the store; the slots before it are
+        // dropped once their particles are released. A secondary still to
+        // come has an open parent with a lower track ID, so it never falls
+        // below it; primaries are tracked last-in first-out, so the slots
+        // below the lowest primary still to come are kept as well
+        int first_track_id_;
+
+        // primaries still to be tracked, by track ID minus 1, and the lowest
+        // track ID among them (number of primaries + 1 once all are done)
+        std::vector< char > pending_primaries_;
+        int lowest_pending_primary_;
+
+        void PrimaryDone(int const);
+
+        // pruning marks of the slots, set by kept descendants
+        std::vector< char > keep_;
+
+        // MC particles released during the event, for reuse
+        std::vector< MCParticle * > free_particles_;
+        int number_live_particles_;
+
+        // live MC particles that are closed, and can be written and released
+        int number_closed_particles_;
+
+        size_t memory_limit_;
+
+        void Release(size_t const);
+        MCParticle * Slot(int const) const;
+        void CloseAncestors(MCParticle *);
+
+        HitBuffer hits_;
+        VoxelBuffer voxels_;
+
+        // upstream of the event arena, counting the memory the arena had
+        // to take from the heap once its buffer was exhausted
+        class ArenaUpstream : public std::pmr::memory_resource
+        {
+            public:
+
+                inline size_t Bytes() const { return bytes_; }
+                inline void Reset() { bytes_ = 0; }
+
+            private:
+
+                void * do_allocate(size_t bytes, size_t alignment) override
+                {
+                    bytes_ += bytes;
+                    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+                }
+
+                void do_deallocate(void * p, size_t bytes, size_t alignment) override
+                {
+                    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+                }
+
+                bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override
+                {
+                    return this == &other;
+                }
+
+                size_t bytes_ = 0;
+        };
+
+        // event arena backing the MC particles. Its buffer grows to fit the largest event seen, so
+        // steady-state events take no memory from the heap.
+        std::vector< std::byte > arena_buffer_;
+        ArenaUpstream arena_upstream_;
+        std::unique_ptr< std::pmr::monotonic_buffer_resource > arena_;
 
 };
 
@@ -0,0 +1,25 @@
+// -----------------------------------------------------------------------------
+//  PassiveLimitsPhysics.cpp
+//
+//  Class definition of the passive limits physics
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#include "PassiveLimitsPhysics.h"
+
+// Q-Pix includes
+#include "DetectorConstruction.h"
+
+//-----------------------------------------------------------------------------
+PassiveLimitsPhysics::PassiveLimitsPhysics(DetectorConstruction const * detector)
+    : G4StepLimiterPhysics("PassiveLimits"), detector_(detector)
+{
+    SetApplyToAll(true);
+}
+
+//-----------------------------------------------------------------------------
+void PassiveLimitsPhysics::ConstructProcess()
+{
+    if (detector_->HasPassiveLimits()) G4StepLimiterPhysics::ConstructProcess();
+}
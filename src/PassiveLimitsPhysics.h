@@ -0,0 +1,35 @@
+// -----------------------------------------------------------------------------
+//  PassiveLimitsPhysics.h
+//
+//  Class definition of the passive limits physics
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#ifndef PassiveLimitsPhysics_h
+#define PassiveLimitsPhysics_h 1
+
+// GEANT4 includes
+#include "G4StepLimiterPhysics.hh"
+
+class DetectorConstruction;
+
+// G4StepLimiterPhysics, applied to all particles, for the minimum kinetic
+// energy and maximum time of tracks in the passive volumes. The processes
+// are only added if one of the limits is set when the physics is
+// constructed at /run/initialize, so that runs without limits don't pay
+// for them on every step.
+class PassiveLimitsPhysics : public G4StepLimiterPhysics {
+
+    public:
+
+        PassiveLimitsPhysics(DetectorConstruction const *);
+
+        virtual void ConstructProcess();
+
+    private:
+
+        DetectorConstruction const * detector_;
+};
+
+#endif
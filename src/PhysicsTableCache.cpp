@@ -0,0 +1,178 @@
+// -----------------------------------------------------------------------------
+//  PhysicsTableCache.cpp
+//
+//  Class definition of the physics table cache
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#include "PhysicsTableCache.h"
+
+// GEANT4 includes
+#include "G4GenericMessenger.hh"
+#include "G4Material.hh"
+#include "G4ProductionCuts.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4RunManagerKernel.hh"
+#include "G4Threading.hh"
+#include "G4VUserPhysicsList.hh"
+#include "G4Version.hh"
+
+// C++ includes
+#include <cstdint>
+#include <cstdlib>
+#include <experimental/filesystem>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+
+G4String PhysicsTableCache::directory_;
+std::string PhysicsTableCache::configuration_;
+std::string PhysicsTableCache::key_directory_;
+PhysicsTableCache::Status PhysicsTableCache::status_ = PhysicsTableCache::kOff;
+
+//-----------------------------------------------------------------------------
+PhysicsTableCache::PhysicsTableCache(std::string const & configuration)
+    : G4VPhysicsConstructor("PhysicsTableCache")
+{
+    configuration_ = configuration;
+
+    char const * directory = std::getenv("QPIX_PHYSICS_CACHE");
+    if (directory) directory_ = directory;
+
+    msg_ = new G4GenericMessenger(this, "/physics_cache/", "Control commands of the physics table cache.");
+    msg_->DeclareProperty("directory", directory_,
+        "Retrieve the physics tables from, or store them in, this directory (empty: no cache); set before /run/initialize.");
+}
+
+//-----------------------------------------------------------------------------
+PhysicsTableCache::~PhysicsTableCache()
+{
+    delete msg_;
+}
+
+//-----------------------------------------------------------------------------
+void PhysicsTableCache::ConstructProcess()
+{
+    // the master builds the tables the workers share
+    if (!G4Threading::IsMasterThread()) return;
+
+    status_ = kOff;
+    if (directory_.empty()) return;
+
+    key_directory_ = directory_ + "/" + Key();
+
+    G4VUserPhysicsList * physics_list = G4RunManagerKernel::GetRunManagerKernel()->GetPhysicsList();
+
+    if (std::experimental::filesystem::is_directory(key_directory_))
+    {
+        physics_list->SetPhysicsTableRetrieved(key_directory_);
+        status_ = kRetrieving;
+    }
+    else
+    {
+        status_ = kBuilding;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void PhysicsTableCache::EndInitialization()
+{
+    if (status_ == kOff) return;
+
+    G4VUserPhysicsList * physics_list = G4RunManagerKernel::GetRunManagerKernel()->GetPhysicsList();
+
+    // the cuts may have changed since /run/initialize, so the tables just
+    // built belong to the key of the cuts in use now
+    std::string const key_directory = directory_ + "/" + Key();
+
+    // Geant4 falls back to building the tables when the retrieved ones
+    // don't match the materials and cuts
+    if (status_ == kRetrieving && physics_list->IsPhysicsTableRetrieved())
+    {
+        G4cout << "PhysicsTableCache: retrieved the physics tables from " << key_directory_ << G4endl;
+        status_ = kDone;
+        return;
+    }
+
+    // nothing changed since the previous run
+    if (status_ == kDone && key_directory == key_directory_) return;
+
+    if (status_ == kRetrieving && key_directory == key_directory_)
+    {
+        G4cout << "PhysicsTableCache: the physics tables in " << key_directory_
+               << " are stale and were rebuilt" << G4endl;
+        std::experimental::filesystem::remove_all(key_directory_);
+    }
+
+    key_directory_ = key_directory;
+    status_ = kDone;
+
+    if (std::experimental::filesystem::is_directory(key_directory_)) return;
+
+    G4cout << "PhysicsTableCache: no physics tables in " << key_directory_
+           << ", built them" << G4endl;
+
+    // concurrent jobs with the same key each store into a directory of
+    // their own, and the first one to finish moves it into place
+    std::string const temporary = key_directory_ + ".tmp" + std::to_string(getpid());
+    std::error_code error;
+    std::experimental::filesystem::create_directories(temporary, error);
+
+    if (!error && physics_list->StorePhysicsTable(temporary))
+    {
+        std::experimental::filesystem::rename(temporary, key_directory_, error);
+        if (!error)
+        {
+            G4cout << "PhysicsTableCache: stored the physics tables in " << key_directory_ << G4endl;
+        }
+    }
+    else
+    {
+        G4cout << "PhysicsTableCache: could not store the physics tables in " << key_directory_ << G4endl;
+    }
+    std::experimental::filesystem::remove_all(temporary, error);
+}
+
+
+//-----------------------------------------------------------------------------
+std::string PhysicsTableCache::Key()
+{
+    std::ostringstream description;
+
+    description << configuration_ << "\n" << G4Version << "\n";
+
+    // the printout of a material has its density, state and element
+    // composition
+    for (auto const material : *G4Material::GetMaterialTable())
+    {
+        description << *material << "\n";
+    }
+
+    for (auto const region : *G4RegionStore::GetInstance())
+    {
+        description << region->GetName();
+        G4ProductionCuts const * cuts = region->GetProductionCuts();
+        if (cuts)
+        {
+            for (auto const cut : cuts->GetProductionCuts()) description << " " << cut;
+        }
+        description << "\n";
+    }
+
+    G4VUserPhysicsList const * physics_list = G4RunManagerKernel::GetRunManagerKernel()->GetPhysicsList();
+    description << physics_list->GetDefaultCutValue() << "\n";
+
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char const c : description.str())
+    {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+
+    std::ostringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << hash;
+
+    return key.str();
+}
@@ -0,0 +1,67 @@
+// -----------------------------------------------------------------------------
+//  PhysicsTableCache.h
+//
+//  Class definition of the physics table cache
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#ifndef PhysicsTableCache_h
+#define PhysicsTableCache_h 1
+
+// GEANT4 includes
+#include "G4VPhysicsConstructor.hh"
+
+// C++ includes
+#include <string>
+
+class G4GenericMessenger;
+
+// Keeps the physics tables built by the master in a cache directory, under a
+// key that hashes the physics configuration, the Geant4 version, the
+// materials and the production cuts. Registered last in the physics list,
+// it looks the key up when the processes are constructed at
+// /run/initialize, so that the tables are retrieved instead of built; the
+// run action stores freshly built tables at the start of a run, under the
+// key of the cuts in use then.
+// Geant4 checks the retrieved cuts against the current materials and cuts
+// itself, and rebuilds the tables if they don't match.
+class PhysicsTableCache : public G4VPhysicsConstructor {
+
+    public:
+
+        // the string describes the physics configuration: the physics list
+        // and any constructors added to it
+        PhysicsTableCache(std::string const &);
+        ~PhysicsTableCache();
+
+        virtual void ConstructParticle() {}
+        virtual void ConstructProcess();
+
+        // store the tables if they were built rather than retrieved, under
+        // the key of the cuts in use, and log the cache status; called on
+        // the master at the start of every run, since the cuts can change
+        // between runs
+        static void EndInitialization();
+
+    private:
+
+        // directory of the cache; empty for no cache. Defaults to the
+        // QPIX_PHYSICS_CACHE environment variable
+        static G4String directory_;
+
+        static std::string configuration_;
+
+        // directory of the tables of the current key
+        static std::string key_directory_;
+
+        enum Status { kOff, kRetrieving, kBuilding, kDone };
+        static Status status_;
+
+        G4GenericMessenger * msg_;
+
+        // FNV-1a hash of the configuration, materials and cuts
+        static std::string Key();
+};
+
+#endif
@@ -9,6 +9,8 @@
 #include "PrimaryGeneration.h"
 
 // Q-Pix includes
+#include "AllocationCounter.h"
+#include "DetectorConstruction.h"
 #include "MCTruthManager.h"
 #include "GeneratorParticle.h"
 
@@ -29,21 +31,29 @@
 
 
 #include "G4GenericMessenger.hh"
+#include "G4RunManager.hh"
+#include "G4Run.hh"
+#include "G4Threading.hh"
 #include "Randomize.hh"
 
 // C++ includes
 #include <stdlib.h>
 #include <math.h>
+#include <algorithm>
 
 PrimaryGeneration::PrimaryGeneration()
   : G4VUserPrimaryGeneratorAction(),
     decay_at_time_zero_(false),
+    seed_(0),
     particle_gun_(0)
 {
   msg_ = new G4GenericMessenger(this, "/Inputs/", "Control commands of the ion primary generator.");
   msg_->DeclareProperty("Particle_Type", Particle_Type_,  "which particle?");
   msg_->DeclareProperty("decay_at_time_zero", decay_at_time_zero_,
                         "Set to true to make unstable isotopes decay at t=0.");
+  msg_->DeclareProperty("seed", seed_,
+                        "Run seed; if non-zero, every event gets its own random "
+                        "stream derived from (seed, run ID, event ID).");
 
   particle_gun_ = new G4GeneralParticleSource();
 
@@ -68,27 +78,54 @@ PrimaryGeneration::~PrimaryGeneration()
 
 void PrimaryGeneration::GeneratePrimaries(G4Event* event)
 {
-  // get MC truth manager
-  MCTruthManager * mc_truth_manager = MCTruthManager::Instance();
+  AllocationCounter::SetPhase(AllocationCounter::kGeneration);
 
-  // get detector dimensions
-  if (!detector_solid_vol_)
+  // reseed the engine so that this event's random sequence depends only on
+  // (seed, run ID, event ID): any event can be reproduced on its own, and
+  // results do not depend on the thread or order the events ran in.
+  // MixMax seeded this way starts a unique, non-overlapping stream.
+  if (seed_ != 0)
   {
-    G4LogicalVolume* detector_logic_vol
-      = G4LogicalVolumeStore::GetInstance()->GetVolume("detector.logical");
-    if (detector_logic_vol) detector_solid_vol_ = dynamic_cast<G4Box*>(detector_logic_vol->GetSolid());
+    if (!dynamic_cast< CLHEP::MixMaxRng * >(G4Random::getTheEngine()))
+    {
+      G4Exception("PrimaryGeneration::GeneratePrimaries", "[seed]", FatalException,
+                  "per-event seeding needs the MixMax random engine");
+    }
+
+    long seeds[5] = { seed_,
+                      G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID(),
+                      event->GetEventID(),
+                      0,
+                      0 };
+    G4Random::getTheEngine()->setSeeds(seeds, 4);
   }
-  if (detector_solid_vol_)
+
+  // get MC truth manager
+  MCTruthManager * mc_truth_manager = MCTruthManager::Instance();
+
+  // in multithreaded mode a supernova readout window can be split into
+  // sub-events that are tracked concurrently; consecutive event IDs are
+  // the sub-events of one window
+  int number_sub_events = 1;
+  if (Particle_Type_ == "SUPERNOVA" && G4Threading::IsMultithreadedApplication())
   {
-    detector_length_x_ = detector_solid_vol_->GetXHalfLength() * 2.;
-    detector_length_y_ = detector_solid_vol_->GetYHalfLength() * 2.;
-    detector_length_z_ = detector_solid_vol_->GetZHalfLength() * 2.;
+    number_sub_events = std::max(super->Sub_Events(), 1);
   }
 
+  mc_truth_manager->SetEvent(event->GetEventID() / number_sub_events);
+  mc_truth_manager->SetSubEvent(event->GetEventID() % number_sub_events, number_sub_events);
+
   if (Particle_Type_ ==  "SUPERNOVA")
   {
-    super->Get_Detector_Dimensions(detector_length_x_, detector_length_y_, detector_length_z_);
-    super->Gen_Supernova_Background(event);
+    // the workers share the master's detector construction
+    DetectorConstruction const * detector_construction =
+      static_cast< DetectorConstruction const * >(
+        G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+    super->Set_Target(detector_construction->GetTargetRadius(),
+                      detector_construction->GetTargetLength(),
+                      detector_construction->GetTargetMass());
+
+    super->Gen_Supernova_Background(event, event->GetEventID() % number_sub_events, number_sub_events);
   }
 
   else
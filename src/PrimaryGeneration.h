@@ -12,7 +12,6 @@
 // GEANT4 includes
 #include "G4VUserPrimaryGeneratorAction.hh"
 
-#include "G4Box.hh"
 #include "G4Event.hh"
 #include "G4GeneralParticleSource.hh"
 #include "G4ParticleTable.hh"
@@ -34,6 +33,8 @@ class PrimaryGeneration : public G4VUserPrimaryGeneratorAction
     virtual ~PrimaryGeneration();
     virtual void GeneratePrimaries(G4Event*);
 
+    inline Supernova const * GetSupernova() const { return super; }
+
   protected:
 
     // GEANT4 dictionary of particles
@@ -47,18 +48,16 @@ class PrimaryGeneration : public G4VUserPrimaryGeneratorAction
 
     bool decay_at_time_zero_;
 
+    // run seed of the per-event random streams; 0 keeps the engine's
+    // sequential stream
+    int seed_;
+
     G4GeneralParticleSource * particle_gun_;
 
     SupernovaTiming * supernova_timing_;
 
     Supernova * super;
 
-    double detector_length_x_;
-    double detector_length_y_;
-    double detector_length_z_;
-
-    G4Box* detector_solid_vol_;
-
 };
 
 #endif
@@ -0,0 +1,103 @@
+// -----------------------------------------------------------------------------
+//  ProcessRegistry.cpp
+//
+//  Class definition of the process registry
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#include "ProcessRegistry.h"
+
+// GEANT4 includes
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4VProcess.hh"
+
+// C++ includes
+#include <set>
+
+G4ThreadLocal std::unordered_map< G4VProcess const *, int > * ProcessRegistry::cache_ = 0;
+
+//-----------------------------------------------------------------------------
+ProcessRegistry::ProcessRegistry()
+{
+    // keep the keys of the processes known before the registry existed
+    for (auto const & name : { "primary", "eIoni", "msc", "compt", "phot",
+                               "eBrem", "ionIoni", "hIoni", "RadioactiveDecayBase",
+                               "CoulombScat", "Rayl", "Transportation", "annihil",
+                               "conv", "hadElastic", "nCapture", "neutronInelastic",
+                               "photonNuclear" })
+    {
+        this->Key(name);
+    }
+}
+
+//-----------------------------------------------------------------------------
+ProcessRegistry * ProcessRegistry::Instance()
+{
+    // one instance for all threads; the initialization is thread safe
+    static ProcessRegistry registry;
+    return &registry;
+}
+
+//-----------------------------------------------------------------------------
+int ProcessRegistry::Key(G4VProcess const * process)
+{
+    if (!process) return -1;
+
+    if (!cache_) cache_ = new std::unordered_map< G4VProcess const *, int >();
+
+    auto const it = cache_->find(process);
+    if (it != cache_->end()) return it->second;
+
+    int const key = this->Key(process->GetProcessName());
+    cache_->emplace(process, key);
+
+    return key;
+}
+
+//-----------------------------------------------------------------------------
+int ProcessRegistry::Key(std::string const & name)
+{
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    auto const it = keys_.find(name);
+    if (it != keys_.end()) return it->second;
+
+    int const key = names_.size();
+    names_.push_back(name);
+    keys_.emplace(name, key);
+
+    return key;
+}
+
+//-----------------------------------------------------------------------------
+void ProcessRegistry::RegisterPhysicsList()
+{
+    std::set< std::string > names;
+
+    auto particle_iterator = G4ParticleTable::GetParticleTable()->GetIterator();
+    particle_iterator->reset();
+    while ((*particle_iterator)())
+    {
+        G4ProcessManager const * process_manager = particle_iterator->value()->GetProcessManager();
+        if (!process_manager) continue;
+
+        G4ProcessVector const * processes = process_manager->GetProcessList();
+        for (size_t index = 0; index < processes->size(); ++index)
+        {
+            names.insert((*processes)[index]->GetProcessName());
+        }
+    }
+
+    for (auto const & name : names) this->Key(name);
+}
+
+//-----------------------------------------------------------------------------
+std::vector< std::string > ProcessRegistry::Names() const
+{
+    std::lock_guard< std::mutex > lock(mutex_);
+    return names_;
+}
@@ -0,0 +1,62 @@
+// -----------------------------------------------------------------------------
+//  ProcessRegistry.h
+//
+//  Class definition of the process registry
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#ifndef ProcessRegistry_h
+#define ProcessRegistry_h 1
+
+// GEANT4 includes
+#include "globals.hh"
+
+// C++ includes
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class G4VProcess;
+
+// Maps process names to small integer keys. The keys are shared by all
+// threads, so that the per-worker files agree with each other; each thread
+// caches the key of every G4VProcess it has seen, so the hot path is a
+// pointer lookup. The processes of the physics list are registered up
+// front in name order, so that the keys don't depend on the order the
+// processes first occur in; the table of names is also written to the
+// metadata of every output file.
+class ProcessRegistry {
+
+    public:
+
+        static ProcessRegistry * Instance();
+
+        // key of a process, registering it on first use; -1 for no process
+        int Key(G4VProcess const *);
+        int Key(std::string const &);
+
+        // process names indexed by key
+        std::vector< std::string > Names() const;
+
+        // register the processes of every particle of the physics list, in
+        // name order; called on the master once the physics is built
+        void RegisterPhysicsList();
+
+    private:
+
+        ProcessRegistry();
+
+        // per-thread cache of the process keys
+        static G4ThreadLocal std::unordered_map< G4VProcess const *, int > * cache_;
+
+        mutable std::mutex mutex_;
+
+        std::vector< std::string >   names_;
+        std::map< std::string, int > keys_;
+
+};
+
+#endif
@@ -10,25 +10,38 @@
 #include "DetectorConstruction.h"
 
 // Q-Pix includes
+#include "AllocationCounter.h"
 #include "AnalysisManager.h"
+#include "EventAction.h"
 #include "MCTruthManager.h"
+#include "PhysicsTableCache.h"
+#include "ProcessRegistry.h"
+#include "StartupTiming.h"
+#include "StackingAction.h"
+#include "TrackingSD.h"
 
 // GEANT4 includes
 #include "G4Box.hh"
 #include "G4LogicalVolumeStore.hh"
 #include "G4Run.hh"
+#include "G4RunManager.hh"
+#include "G4SDManager.hh"
+#include "G4Threading.hh"
 
 // C++ includes
 #include <experimental/filesystem>
 
 
-RunAction::RunAction(): G4UserRunAction(), multirun_(false)
+RunAction::RunAction(): G4UserRunAction(), multirun_(false), writer_queue_depth_(0)
 {
     messenger_ = new G4GenericMessenger(this, "/Inputs/");
     messenger_->DeclareProperty("root_output", root_output_path_,
                                 "path to output ROOT file");
     messenger_->DeclareProperty("multirun", multirun_,
                                 "Multiple runs");
+    messenger_->DeclareProperty("writer_queue_depth", writer_queue_depth_,
+                                "Events queued for the background ROOT writer "
+                                "(0 writes synchronously)");
 }
 
 
@@ -42,6 +55,14 @@ void RunAction::BeginOfRunAction(const G4Run* run)
 {
     G4cout << "RunAction::BeginOfRunAction: Run #" << run->GetRunID() << " start." << G4endl;
 
+    // the physics tables are built, or retrieved, by now
+    if (IsMaster()) PhysicsTableCache::EndInitialization();
+
+    // fix the process keys before any worker tracks an event
+    if (IsMaster()) ProcessRegistry::Instance()->RegisterPhysicsList();
+
+    StartupTiming::Record(StartupTiming::kRunStart);
+
     std::string root_output_path = root_output_path_;
 
     if (multirun_)
@@ -78,30 +99,100 @@ void RunAction::BeginOfRunAction(const G4Run* run)
 
     }
 
+    run_output_path_ = root_output_path;
+
+    // in multithreaded mode only the workers track events; the master books
+    // the merged output at the end of the run
+    if (IsMaster() && G4Threading::IsMultithreadedApplication()) return;
+
+    // each worker writes to its own file, tagged with the thread ID
+    if (G4Threading::IsWorkerThread())
+    {
+        root_output_path = WorkerOutputPath(root_output_path, G4Threading::G4GetThreadId());
+    }
+
     // get run number
     AnalysisManager * analysis_manager = AnalysisManager::Instance();
     // analysis_manager->Book(root_output_path_);
-    analysis_manager->Book(root_output_path);
+    analysis_manager->Book(root_output_path, writer_queue_depth_, G4Threading::IsWorkerThread());
     analysis_manager->SetRun(run->GetRunID());
 
+    // book the voxel branches if the sensitive detector sums up voxels
+    TrackingSD const * tracking_sd = dynamic_cast< TrackingSD const * >(
+        G4SDManager::GetSDMpointer()->FindSensitiveDetector("/G4QPIX/TRACKING", false));
+    if (tracking_sd)
+    {
+        analysis_manager->SetVoxelGrid(tracking_sd->VoxelPitch() / CLHEP::cm,
+                                       tracking_sd->VoxelTimeBin() / CLHEP::ns);
+    }
+
     // reset event variables
     analysis_manager->EventReset();
 
     // get MC truth manager
     MCTruthManager * mc_truth_manager = MCTruthManager::Instance();
 
+    // bound the memory of the MC truth, writing events in chunks
+    EventAction const * event_action = static_cast< EventAction const * >(
+        G4RunManager::GetRunManager()->GetUserEventAction());
+    size_t const max_truth_memory = event_action ? event_action->MaxTruthMemory() : 0;
+    mc_truth_manager->SetMemoryLimit(max_truth_memory << 20);
+    if (max_truth_memory > 0) analysis_manager->EnableChunks();
+
+    // the merge cuts on the energy of the readout windows split into
+    // sub-events
+    if (event_action) analysis_manager->SetEnergyThreshold(event_action->EnergyThreshold() / CLHEP::MeV);
+
     // reset event in MC truth manager
     mc_truth_manager->EventReset();
+
+    AllocationCounter::Reset();
+
+    StackingAction * stacking_action = const_cast< StackingAction * >(
+        static_cast< StackingAction const * >(G4RunManager::GetRunManager()->GetUserStackingAction()));
+    if (stacking_action) stacking_action->Reset();
 }
 
 
-void RunAction::EndOfRunAction(const G4Run*)
+void RunAction::EndOfRunAction(const G4Run* run)
 {
+    AllocationCounter::Report();
+
+    StackingAction const * stacking_action = static_cast< StackingAction const * >(
+        G4RunManager::GetRunManager()->GetUserStackingAction());
+    if (stacking_action) stacking_action->Report();
+
     // get analysis manager
     AnalysisManager * analysis_manager = AnalysisManager::Instance();
+
+    // in multithreaded mode the master merges the worker files into the
+    // requested output file, ordered by event number
+    bool const merge = IsMaster() && G4Threading::IsMultithreadedApplication();
+
+    std::vector< std::string > worker_paths;
+
+    if (merge)
+    {
+        // threads that never picked up any work have no file
+        int const number_threads = G4RunManager::GetRunManager()->GetNumberOfThreads();
+        for (int thread_id = 0; thread_id < number_threads; ++thread_id)
+        {
+            std::string const path = WorkerOutputPath(run_output_path_, thread_id);
+            if (std::experimental::filesystem::exists(path)) worker_paths.push_back(path);
+        }
+
+        G4cout << "RunAction::EndOfRunAction: merging " << worker_paths.size()
+               << " worker files into " << run_output_path_ << G4endl;
+
+        analysis_manager->Book(run_output_path_);
+        analysis_manager->SetRun(run->GetRunID());
+        analysis_manager->Merge(worker_paths);
+    }
 	
-    // get detector construction
-    DetectorConstruction * detector_construction = new DetectorConstruction();
+    // get detector construction; the workers share the master's instance
+    DetectorConstruction const * detector_construction =
+        static_cast< DetectorConstruction const * >(
+            G4RunManager::GetRunManager()->GetUserDetectorConstruction());
 
     // get detector dimensions
     double const detector_length_x = detector_construction->GetTargetRadius();
@@ -115,5 +206,22 @@ void RunAction::EndOfRunAction(const G4Run*)
 
     // save run to ROOT file
     analysis_manager->Save();
+
+    // the worker files are not needed once they are merged
+    for (auto const & path : worker_paths)
+    {
+        std::experimental::filesystem::remove(path);
+    }
 }
 
+
+std::string RunAction::WorkerOutputPath(std::string const & output_path, int const thread_id)
+{
+    std::experimental::filesystem::path path = output_path;
+
+    std::string parent_path = path.parent_path();
+    std::string stem = path.stem();
+    std::string extension = path.extension();
+
+    return parent_path + "/" + stem + "_t" + std::to_string(thread_id) + extension;
+}
@@ -12,6 +12,8 @@
 #include <G4UserRunAction.hh>
 #include "G4GenericMessenger.hh"
 
+#include <string>
+
 
 class RunAction: public G4UserRunAction
 {
@@ -24,9 +26,16 @@ class RunAction: public G4UserRunAction
 
     private:
 
+        // per-thread output file of worker thread_id
+        static std::string WorkerOutputPath(std::string const &, int const);
+
         G4GenericMessenger * messenger_;
         G4String root_output_path_;
         bool multirun_;
+        int writer_queue_depth_;
+
+        // output path of the current run
+        std::string run_output_path_;
 };
 
 #endif
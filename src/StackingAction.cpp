@@ -0,0 +1,121 @@
+// -----------------------------------------------------------------------------
+//  G4_QPIX | StackingAction.cpp
+//
+//  Kills tracks that cannot contribute to the readout before they are tracked.
+//   * Author: Everybody is an author!
+//   * Creation date: 16 Oct 2026
+// -----------------------------------------------------------------------------
+
+#include "StackingAction.h"
+
+// Q-Pix includes
+#include "MCTruthManager.h"
+#include "PrimaryGeneration.h"
+#include "TrackingSD.h"
+
+// GEANT4 includes
+#include "G4GenericMessenger.hh"
+#include "G4RunManager.hh"
+#include "G4SDManager.hh"
+#include "G4Threading.hh"
+#include "G4Track.hh"
+
+// C++ includes
+#include <algorithm>
+#include <cstdlib>
+
+
+StackingAction::StackingAction():
+  G4UserStackingAction(), kill_outside_window_(false), window_(0.), cutoff_(0.),
+  kill_neutrinos_(false)
+{
+    msg_ = new G4GenericMessenger(this, "/stacking/", "Control commands of the track stacking.");
+    msg_->DeclareProperty("kill_outside_window", kill_outside_window_,
+        "Kill tracks born before -Event_Window or after Event_Cutoff instead of tracking them.");
+    msg_->DeclareProperty("kill_neutrinos", kill_neutrinos_, "Kill neutrinos instead of tracking them.");
+    msg_->DeclareMethod("kill_pdg", &StackingAction::AddKillPDGCode,
+        "PDG code of other non-interacting particles to kill instead of tracking them.");
+}
+
+
+StackingAction::~StackingAction()
+{
+    delete msg_;
+}
+
+
+void StackingAction::AddKillPDGCode(int pdg_code)
+{
+    kill_pdg_codes_.push_back(pdg_code);
+}
+
+
+void StackingAction::PrepareNewEvent()
+{
+    window_ = 0.;
+    cutoff_ = 0.;
+
+    if (!kill_outside_window_) return;
+
+    PrimaryGeneration const * primary_generation = static_cast< PrimaryGeneration const * >(
+        G4RunManager::GetRunManager()->GetUserPrimaryGeneratorAction());
+    if (primary_generation) window_ = primary_generation->GetSupernova()->Event_Window();
+
+    TrackingSD const * tracking_sd = dynamic_cast< TrackingSD const * >(
+        G4SDManager::GetSDMpointer()->FindSensitiveDetector("/G4QPIX/TRACKING", false));
+    if (tracking_sd) cutoff_ = tracking_sd->EventCutoff();
+}
+
+
+G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(const G4Track* track)
+{
+    bool outside_window = false;
+    bool species = false;
+
+    if (kill_outside_window_)
+    {
+        double const time = track->GetGlobalTime();
+        outside_window = (window_ > 0. && time < -window_) || (cutoff_ > 0. && time > cutoff_);
+    }
+
+    if (!outside_window)
+    {
+        int const pdg_code = track->GetDefinition()->GetPDGEncoding();
+        int const abs_pdg_code = std::abs(pdg_code);
+        species = (kill_neutrinos_ && (abs_pdg_code == 12 || abs_pdg_code == 14 || abs_pdg_code == 16))
+               || std::find(kill_pdg_codes_.begin(), kill_pdg_codes_.end(), pdg_code) != kill_pdg_codes_.end();
+    }
+
+    if (!outside_window && !species) return fUrgent;
+
+    KillCount & count = killed_[track->GetDefinition()->GetParticleName()];
+    if (outside_window) count.outside_window += 1;
+    else count.species += 1;
+
+    // the parent was told about this secondary when it finished
+    MCTruthManager::Instance()->DropTrack(track->GetTrackID(), track->GetParentID());
+
+    return fKill;
+}
+
+
+void StackingAction::Report() const
+{
+    if (killed_.empty()) return;
+
+    G4cout << "StackingAction: thread " << G4Threading::G4GetThreadId()
+           << ", killed tracks" << G4endl;
+
+    for (auto const & count : killed_)
+    {
+        G4cout << "  " << count.first << ": "
+               << count.second.outside_window << " outside the time window, "
+               << count.second.species << " by species" << G4endl;
+    }
+}
+
+
+void StackingAction::Reset()
+{
+    killed_.clear();
+}
@@ -0,0 +1,61 @@
+// -----------------------------------------------------------------------------
+//  G4_QPIX | StackingAction.h
+//
+//  Kills tracks that cannot contribute to the readout before they are tracked.
+//   * Author: Everybody is an author!
+//   * Creation date: 16 Oct 2026
+// -----------------------------------------------------------------------------
+
+#ifndef STACKING_ACTION_H
+#define STACKING_ACTION_H
+
+#include <G4UserStackingAction.hh>
+
+#include <map>
+#include <string>
+#include <vector>
+
+
+class G4GenericMessenger;
+
+class StackingAction: public G4UserStackingAction
+{
+    public:
+
+        StackingAction();
+        virtual ~StackingAction();
+
+        virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track*);
+        virtual void PrepareNewEvent();
+
+        void AddKillPDGCode(int);
+
+        // number of killed tracks by particle name, printed per thread
+        void Report() const;
+        void Reset();
+
+    private:
+
+        G4GenericMessenger* msg_; // Messenger for configuration parameters
+
+        // tracks born outside [-Event_Window, Event_Cutoff] are killed;
+        // the bounds are taken from the generator and the sensitive
+        // detector at the start of every event, 0 disables a bound
+        bool kill_outside_window_;
+        double window_;
+        double cutoff_;
+
+        // tracks of these PDG codes are killed
+        bool kill_neutrinos_;
+        std::vector< int > kill_pdg_codes_;
+
+        struct KillCount
+        {
+            long outside_window = 0;
+            long species = 0;
+        };
+
+        std::map< std::string, KillCount > killed_;
+};
+
+#endif
@@ -0,0 +1,63 @@
+// -----------------------------------------------------------------------------
+//  StartupTiming.cpp
+//
+//  Class definition of the startup timing
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#include "StartupTiming.h"
+
+// GEANT4 includes
+#include "G4ios.hh"
+
+// C++ includes
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace {
+
+    std::mutex mutex_;
+
+    // set once a mark is recorded; read without the lock, so that the marks
+    // reached again on every run and every event cost one atomic load
+    std::atomic< bool > recorded_[StartupTiming::kNumberMarks];
+    std::chrono::steady_clock::time_point times_[StartupTiming::kNumberMarks];
+
+    // seconds between two marks, 0 if either was not reached
+    double Seconds(StartupTiming::Mark const from, StartupTiming::Mark const to)
+    {
+        if (!recorded_[from] || !recorded_[to]) return 0;
+        return std::chrono::duration< double >(times_[to] - times_[from]).count();
+    }
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+void StartupTiming::Record(Mark const mark)
+{
+    if (recorded_[mark].load(std::memory_order_acquire)) return;
+
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    if (recorded_[mark].load(std::memory_order_relaxed)) return;
+
+    times_[mark] = std::chrono::steady_clock::now();
+    recorded_[mark].store(true, std::memory_order_release);
+
+    if (mark != kFirstEvent) return;
+
+    // the physics phase runs from the geometry to the start of the first
+    // run: process construction and the physics tables
+    double const root_init   = Seconds(kStart, kRootInit);
+    double const geometry    = Seconds(kGeometryStart, kGeometryEnd);
+    double const physics     = Seconds(kGeometryEnd, kRunStart);
+    double const first_event = Seconds(kRunStart, kFirstEvent);
+    double const total       = Seconds(kStart, kFirstEvent);
+
+    G4cout << "StartupTiming: ROOT init " << root_init << " s, geometry " << geometry
+           << " s, physics " << physics << " s, first event " << first_event
+           << " s, other " << total - root_init - geometry - physics - first_event
+           << " s, total " << total << " s" << G4endl;
+}
@@ -0,0 +1,26 @@
+// -----------------------------------------------------------------------------
+//  StartupTiming.h
+//
+//  Class definition of the startup timing
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#ifndef StartupTiming_h
+#define StartupTiming_h 1
+
+// Records when the job reaches each step of its startup and prints the time
+// spent in every phase once the first event is done. Only the first time a
+// mark is reached counts, so later runs and other threads don't move it.
+class StartupTiming {
+
+    public:
+
+        enum Mark { kStart, kRootInit, kGeometryStart, kGeometryEnd,
+                    kRunStart, kFirstEvent, kNumberMarks };
+
+        static void Record(Mark const);
+
+};
+
+#endif
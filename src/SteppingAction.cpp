@@ -9,8 +9,7 @@
 #include "SteppingAction.h"
 
 
-#include "AnalysisManager.h"
-#include "G4VProcess.hh"
+#include "ProcessRegistry.h"
 
 
 SteppingAction::SteppingAction(): G4UserSteppingAction()
@@ -25,7 +24,6 @@ SteppingAction::~SteppingAction()
 
 void SteppingAction::UserSteppingAction(const G4Step* step)
 {
-    AnalysisManager * analysis_manager = AnalysisManager::Instance();
-
-    analysis_manager->AddProcess(step->GetPostStepPoint()->GetProcessDefinedStep()->GetProcessName());
+    // register every process seen, also outside the sensitive volume
+    ProcessRegistry::Instance()->Key(step->GetPostStepPoint()->GetProcessDefinedStep());
 }
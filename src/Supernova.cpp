@@ -14,33 +14,68 @@
 
 #include "G4ParticleDefinition.hh"
 #include "G4GenericMessenger.hh"
+#include "G4Poisson.hh"
 
 #include "Supernova.h"
 
 #include <math.h> 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
 
 
 //-----------------------------------------------------------------------------
 Supernova::Supernova():
-N_Ar39_Decays_(0),N_Ar42_Decays_(0),
-N_Kr85_Decays_(0),N_Co60_Decays_(0),
-N_K40_Decays_(0),N_K42_Decays_(0),
-N_Bi214_Decays_(0),N_Pb214_Decays_(0),
-N_Po210_Decays_(0),N_Rn222_Decays_(0)
+Event_Window_(0.),
+Sub_Events_(1),
+target_radius_(0.),
+target_length_(0.),
+target_mass_(0.),
+Sub_Event_(0),N_Sub_Events_(1)
 {
+    // position samplers of the source regions
+    samplers_["Vol"] = { 3, [this] (double const* u, double& x, double& y, double& z) { Gen_Uniform_Position(u, x, y, z); } };
+    samplers_["APA"] = { 2, [this] (double const* u, double& x, double& y, double& z) { Gen_APA_Position(u, x, y, z); } };
+    samplers_["CPA"] = { 2, [this] (double const* u, double& x, double& y, double& z) { Gen_CPA_Position(u, x, y, z); } };
+
+    // built-in isotopes
+    Push_Isotope(18,  39, 0, "Vol");
+    Push_Isotope(18,  42, 0, "Vol");
+    Push_Isotope(36,  85, 0, "Vol");
+    Push_Isotope(27,  60, 0, "CPA");
+    Push_Isotope(19,  40, 0, "APA");
+    Push_Isotope(19,  42, 0, "Vol");
+    Push_Isotope(83, 214, 0, "Vol");
+    Push_Isotope(82, 214, 0, "Vol");
+    Push_Isotope(84, 210, 0, "APA");
+    Push_Isotope(86, 222, 0, "Vol");
+
     msg_ = new G4GenericMessenger(this, "/Supernova/", "Control commands of the supernova generator.");
     msg_->DeclareProperty("Event_Window", Event_Window_,  "window to simulate the times").SetUnit("ns");
-
-    msg_->DeclareProperty("N_Ar39_Decays", N_Ar39_Decays_,  "number of Ar39 decays");
-    msg_->DeclareProperty("N_Ar42_Decays", N_Ar42_Decays_,  "number of Ar42 decays");
-    msg_->DeclareProperty("N_Kr85_Decays", N_Kr85_Decays_,  "number of Kr85 decays");
-    msg_->DeclareProperty("N_Co60_Decays", N_Co60_Decays_,  "number of Co60 decays");
-    msg_->DeclareProperty("N_K40_Decays", N_K40_Decays_,  "number of K40 decays");
-    msg_->DeclareProperty("N_K42_Decays", N_K42_Decays_,  "number of K42 decays");
-    msg_->DeclareProperty("N_Bi214_Decays", N_Bi214_Decays_,  "number of Bi214 decays");
-    msg_->DeclareProperty("N_Pb214_Decays", N_Pb214_Decays_,  "number of Pb214 decays");
-    msg_->DeclareProperty("N_Po210_Decays", N_Po210_Decays_,  "number of Po210 decays");
-    msg_->DeclareProperty("N_Rn222_Decays", N_Rn222_Decays_,  "number of Rn222 decays");
+    msg_->DeclareProperty("Sub_Events", Sub_Events_,  "split every readout window into this many sub-events, "
+                          "tracked concurrently and reassembled in the output (multithreaded mode only; "
+                          "/run/beamOn then counts sub-events)");
+
+    msg_->DeclareProperty("N_Ar39_Decays", isotopes_[0].N_Decays,  "number of Ar39 decays");
+    msg_->DeclareProperty("N_Ar42_Decays", isotopes_[1].N_Decays,  "number of Ar42 decays");
+    msg_->DeclareProperty("N_Kr85_Decays", isotopes_[2].N_Decays,  "number of Kr85 decays");
+    msg_->DeclareProperty("N_Co60_Decays", isotopes_[3].N_Decays,  "number of Co60 decays");
+    msg_->DeclareProperty("N_K40_Decays", isotopes_[4].N_Decays,  "number of K40 decays");
+    msg_->DeclareProperty("N_K42_Decays", isotopes_[5].N_Decays,  "number of K42 decays");
+    msg_->DeclareProperty("N_Bi214_Decays", isotopes_[6].N_Decays,  "number of Bi214 decays");
+    msg_->DeclareProperty("N_Pb214_Decays", isotopes_[7].N_Decays,  "number of Pb214 decays");
+    msg_->DeclareProperty("N_Po210_Decays", isotopes_[8].N_Decays,  "number of Po210 decays");
+    msg_->DeclareProperty("N_Rn222_Decays", isotopes_[9].N_Decays,  "number of Rn222 decays");
+
+    msg_->DeclareMethod("Isotope", &Supernova::Add_Isotope,
+                        "add an isotope source \"Z A Region N_Decays [Activity]\", Region being Vol, APA or CPA");
+    msg_->DeclareMethod("Isotope_File", &Supernova::Load_Isotopes,
+                        "add the isotope sources of a file, one \"Z A Region N_Decays [Activity]\" per line");
+    msg_->DeclareMethod("Activity", &Supernova::Set_Activity,
+                        "set the activity of an isotope source \"Z A Region Activity\", in Bq/kg for Vol "
+                        "and Bq/m2 for APA and CPA; the decays of the source are then Poisson distributed");
+    msg_->DeclareMethod("Clear_Isotopes", &Supernova::Clear_Isotopes,
+                        "set all decay counts and activities to 0 and remove the added isotope sources");
 
 }
 
@@ -52,246 +87,234 @@ Supernova::~Supernova()
 
 
 //-----------------------------------------------------------------------------
-void Supernova::Gen_Supernova_Background(G4Event* event)
+void Supernova::Push_Isotope(int Atomic_Number, int Atomic_Mass, int N_Decays, std::string const& Region, double Activity)
 {
-    // Generate Ar39
-    for (int ct=0; ct<N_Ar39_Decays_; ct++)
+    auto const sampler = samplers_.find(Region);
+    if (sampler == samplers_.end())
     {
-        decay_time = G4UniformRand() * Event_Window_;
-        if (G4UniformRand() < 0.5){decay_time *= -1.0;}
-
-        Generate_Radioisotope(event, 18, 39, decay_time, "Vol"); //Ar39 from Volume
+        G4Exception("Supernova::Push_Isotope()", "[supernova]", FatalException,
+                    ("unknown isotope region " + Region).c_str());
+        return;
     }
 
-    // Generate Ar42
-    for (int ct=0; ct<N_Ar42_Decays_; ct++)
+    isotopes_.push_back({ Atomic_Number, Atomic_Mass, N_Decays, Region, sampler->second, 0, Activity });
+}
+
+
+//-----------------------------------------------------------------------------
+void Supernova::Add_Isotope(G4String const& Row)
+{
+    std::istringstream stream(Row);
+    int Atomic_Number, Atomic_Mass, N_Decays;
+    std::string Region;
+    double Activity = 0.;
+
+    if (!(stream >> Atomic_Number >> Atomic_Mass >> Region >> N_Decays) ||
+        (!(stream >> Activity) && !stream.eof()))
     {
-        decay_time = G4UniformRand() * Event_Window_;
-        if (G4UniformRand() < 0.5){decay_time *= -1.0;}
-        Generate_Radioisotope(event, 18, 42, decay_time, "Vol"); //Ar42 from Volume
+        G4Exception("Supernova::Add_Isotope()", "[supernova]", FatalException,
+                    ("can not read isotope source \"" + Row + "\"").c_str());
+        return;
     }
 
-    // Generate Kr85
-    for (int ct=0; ct<N_Kr85_Decays_; ct++)
-    {
-        decay_time = G4UniformRand() * Event_Window_;
-        if (G4UniformRand() < 0.5){decay_time *= -1.0;}
+    Push_Isotope(Atomic_Number, Atomic_Mass, N_Decays, Region, Activity);
+}
 
-        Generate_Radioisotope(event, 36, 85, decay_time, "Vol"); //Kr85 from Volume
-    }
 
-    // Generate Co60
-    for (int ct=0; ct<N_Co60_Decays_; ct++)
+//-----------------------------------------------------------------------------
+void Supernova::Set_Activity(G4String const& Row)
+{
+    std::istringstream stream(Row);
+    int Atomic_Number, Atomic_Mass;
+    double Activity;
+    std::string Region;
+
+    if (!(stream >> Atomic_Number >> Atomic_Mass >> Region >> Activity))
     {
-        decay_time = G4UniformRand() * Event_Window_;
-        if (G4UniformRand() < 0.5){decay_time *= -1.0;}
-        Generate_Radioisotope(event, 27, 60, decay_time, "CPA"); //Co60 from CPA
+        G4Exception("Supernova::Set_Activity()", "[supernova]", FatalException,
+                    ("can not read isotope activity \"" + Row + "\"").c_str());
+        return;
     }
-    
-    // Generate K40
-    for (int ct=0; ct<N_K40_Decays_; ct++)
+
+    for (auto & Source : isotopes_)
     {
-        decay_time = G4UniformRand() * Event_Window_;
-        if (G4UniformRand() < 0.5){decay_time *= -1.0;}
-        Generate_Radioisotope(event, 19, 40, decay_time, "APA"); //K40 from APA
+        if (Source.Atomic_Number == Atomic_Number && Source.Atomic_Mass == Atomic_Mass && Source.Region == Region)
+        {
+            Source.Activity = Activity;
+            return;
+        }
     }
 
-    // Generate K42
-    for (int ct=0; ct<N_K42_Decays_; ct++)
+    Push_Isotope(Atomic_Number, Atomic_Mass, 0, Region, Activity);
+}
+
+
+//-----------------------------------------------------------------------------
+void Supernova::Load_Isotopes(G4String const& Path)
+{
+    std::ifstream file(Path);
+    if (!file)
     {
-        decay_time = G4UniformRand() * Event_Window_;
-        if (G4UniformRand() < 0.5){decay_time *= -1.0;}
-        Generate_Radioisotope(event, 19, 42, decay_time, "Vol"); //K42 from Volume
+        G4Exception("Supernova::Load_Isotopes()", "[supernova]", FatalException,
+                    ("can not open isotope file " + Path).c_str());
+        return;
     }
 
-    // Generate Bi214
-    for (int ct=0; ct<N_Bi214_Decays_; ct++)
+    std::string line;
+    while (std::getline(file, line))
     {
-        decay_time = G4UniformRand() * Event_Window_;
-        if (G4UniformRand() < 0.5){decay_time *= -1.0;}
-        Generate_Radioisotope(event, 83, 214, decay_time, "Vol"); //Bi214 from Volume
+        line = line.substr(0, line.find('#'));
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        Add_Isotope(line);
     }
+}
+
 
-    // Generate Pb214
-    for (int ct=0; ct<N_Pb214_Decays_; ct++)
+//-----------------------------------------------------------------------------
+void Supernova::Clear_Isotopes()
+{
+    // the built-in rows stay, as their commands are bound to them
+    isotopes_.resize(10);
+    for (auto & Source : isotopes_)
     {
-        decay_time = G4UniformRand() * Event_Window_;
-        if (G4UniformRand() < 0.5){decay_time *= -1.0;}
-        Generate_Radioisotope(event, 82, 214, decay_time, "Vol"); //Pb214 from Volume
+        Source.N_Decays = 0;
+        Source.Activity = 0.;
     }
+}
+
 
-    // Generate Po210
-    for (int ct=0; ct<N_Po210_Decays_; ct++)
+//-----------------------------------------------------------------------------
+void Supernova::Gen_Supernova_Background(G4Event* event, int const Sub_Event, int const N_Sub_Events)
+{
+    Sub_Event_ = Sub_Event;
+    N_Sub_Events_ = N_Sub_Events;
+
+    for (auto & Source : isotopes_)
     {
-        decay_time = G4UniformRand() * Event_Window_;
-        if (G4UniformRand() < 0.5){decay_time *= -1.0;}
-        Generate_Radioisotope(event, 84, 210, decay_time, "APA"); //Po210 from APA
+        // the decays of a window are Poisson distributed, and so are those
+        // of its sub-events
+        int const N_Decays = Source.Activity > 0. ? G4Poisson(Expected_Decays(Source))
+                                                  : Decays_In_Sub_Event(Source.N_Decays);
+        if (N_Decays < 1) continue;
+
+        // the ion definitions are shared by all decays, and all events
+        if (!Source.Ion)
+        {
+            Source.Ion = G4IonTable::GetIonTable()->GetIon(Source.Atomic_Number, Source.Atomic_Mass, 0.);
+            if (!Source.Ion) G4Exception("SetParticleDefinition()", "[IonGun]", FatalException, " can not create ion ");
+            Source.Ion->SetPDGLifeTime(1.*ps);
+        }
+
+        Generate_Radioisotopes(event, Source, N_Decays);
     }
-    
-    // Generate Rn222
-    for (int ct=0; ct<N_Rn222_Decays_; ct++)
+
+}
+
+
+//-----------------------------------------------------------------------------
+int Supernova::Decays_In_Sub_Event(int const N_Decays) const
+{
+    // spread the decays evenly, the first sub-events take the remainder
+    return N_Decays / N_Sub_Events_ + (Sub_Event_ < N_Decays % N_Sub_Events_ ? 1 : 0);
+}
+
+
+//-----------------------------------------------------------------------------
+double Supernova::Expected_Decays(Isotope_Source const& Source) const
+{
+    // the volume sources are per mass, the APA and CPA ones per area; the
+    // samplers cover the same target volume and end faces
+    double const Exposure = Source.Region == "Vol" ? target_mass_ / kg
+                                                   : M_PI * target_radius_ * target_radius_ / m2;
+    if (Exposure <= 0.)
     {
-        decay_time = G4UniformRand() * Event_Window_;
-        if (G4UniformRand() < 0.5){decay_time *= -1.0;}
-        Generate_Radioisotope(event, 86, 222, decay_time, "Vol"); //Rn222 from Volume
+        G4Exception("Supernova::Expected_Decays()", "[supernova]", FatalException,
+                    "the activities need the target mass and area");
     }
 
+    // the decay times cover [-Event_Window, Event_Window]
+    return Source.Activity * Exposure * 2. * Event_Window_ / s / N_Sub_Events_;
 }
 
 
 //-----------------------------------------------------------------------------
-void Supernova::Generate_Radioisotope(G4Event* event, int Atomic_Number, int Atomic_Mass, double Decay_Time, std::string Region)
+void Supernova::Generate_Radioisotopes(G4Event* event, Isotope_Source const& Source, int N_Decays)
 {
-    G4ParticleDefinition* pdef = G4IonTable::GetIonTable()->GetIon(Atomic_Number, Atomic_Mass, 0.); // Ar39
-    if (!pdef)G4Exception("SetParticleDefinition()", "[IonGun]",FatalException, " can not create ion ");
+    // every decay takes a time, a sign, a direction and a position
+    int const N_Randoms = 4 + Source.Position.N_Randoms;
+    int const Batch_Size = 4096;
+
+    for (int first=0; first<N_Decays; first+=Batch_Size)
+    {
+        int const N_Batch = std::min(Batch_Size, N_Decays - first);
 
-    // pdef->SetPDGLifeTime(1.*CLHEP::ps);
-    pdef->SetPDGLifeTime(1.*ps);
+        randoms_.resize(N_Batch * N_Randoms);
+        G4Random::getTheEngine()->flatArray(randoms_.size(), randoms_.data());
 
-    G4PrimaryParticle* particle = new G4PrimaryParticle(pdef);
+        for (int ct=0; ct<N_Batch; ct++)
+        {
+            double const* u = &randoms_[ct * N_Randoms];
 
-    Random_Direction(Px_hat, Py_hat, Pz_hat, 1);
-    particle->SetMomentumDirection(G4ThreeVector(Px_hat, Py_hat, Pz_hat));
-    particle->SetKineticEnergy(1.*eV); // just an ion sitting
+            double Decay_Time = u[0] * Event_Window_;
+            if (u[1] < 0.5){Decay_Time *= -1.0;}
 
-    if (Region == "Vol")
-    {
-        Gen_Uniform_Position( Ran_X_,  Ran_Y_,  Ran_Z_);
-    }
-    else if (Region == "APA")
-    {
-        Gen_APA_Position( Ran_X_,  Ran_Y_,  Ran_Z_);
-    }
-    else if (Region == "CPA")
-    {
-        Gen_CPA_Position( Ran_X_,  Ran_Y_,  Ran_Z_);
-    }
-    else
-    {
-        G4Exception("invilad ion region", "[supernova]",FatalException, " can not get Region");
+            G4PrimaryParticle* particle = new G4PrimaryParticle(Source.Ion);
+
+            Random_Direction(u + 2, Px_hat, Py_hat, Pz_hat, 1);
+            particle->SetMomentumDirection(G4ThreeVector(Px_hat, Py_hat, Pz_hat));
+            particle->SetKineticEnergy(1.*eV); // just an ion sitting
+
+            Source.Position.Sample(u + 4, Ran_X_,  Ran_Y_,  Ran_Z_);
+
+            G4PrimaryVertex* vertex = new G4PrimaryVertex(G4ThreeVector(Ran_X_,Ran_Y_,Ran_Z_), Decay_Time);
+            vertex->SetPrimary(particle);
+            event->AddPrimaryVertex(vertex);
+        }
     }
-    
-    G4PrimaryVertex* vertex = new G4PrimaryVertex(G4ThreeVector(Ran_X_,Ran_Y_,Ran_Z_), Decay_Time);
-    vertex->SetPrimary(particle);
-    event->AddPrimaryVertex(vertex);    
 }
 
 
 
 //-----------------------------------------------------------------------------
-void Supernova::Gen_Uniform_Position(double& Ran_X, double& Ran_Y, double& Ran_Z)
+void Supernova::Gen_Uniform_Position(double const* u, double& Ran_X, double& Ran_Y, double& Ran_Z)
 {
-    Ran_X = G4UniformRand() * detector_length_x_;
-    Ran_Y = G4UniformRand() * detector_length_y_;
-    Ran_Z = G4UniformRand() * detector_length_z_;
+    // uniform in the target cylinder
+    const double r = target_radius_ * sqrt(u[0]);
+    const double phi = 2*M_PI * u[1];
+    Ran_X = r * cos(phi);
+    Ran_Y = r * sin(phi);
+    Ran_Z = (u[2] - 0.5) * target_length_;
 }
 
 //-----------------------------------------------------------------------------
-void Supernova::Gen_CPA_Position(double& Ran_X, double& Ran_Y, double& Ran_Z)
+void Supernova::Gen_CPA_Position(double const* u, double& Ran_X, double& Ran_Y, double& Ran_Z)
 {
-    Ran_X = G4UniformRand() * detector_length_x_;
-    Ran_Y = G4UniformRand() * detector_length_y_;
-    Ran_Z = detector_length_z_ - 1 *um;
+    // uniform on the cathode, the end face of the target at +z
+    const double r = target_radius_ * sqrt(u[0]);
+    const double phi = 2*M_PI * u[1];
+    Ran_X = r * cos(phi);
+    Ran_Y = r * sin(phi);
+    Ran_Z = 0.5 * target_length_ - 1 *um;
 }
 
 //-----------------------------------------------------------------------------
-void Supernova::Gen_APA_Position(double& Ran_X, double& Ran_Y, double& Ran_Z)
+void Supernova::Gen_APA_Position(double const* u, double& Ran_X, double& Ran_Y, double& Ran_Z)
 {
-
-    double case_weight = G4UniformRand();
-    Ran_X = -10 *m;
-    Ran_Y = -10 *m;
-    Ran_Z = 1 *um;
-
-    if (case_weight <= 0.6)
-    {
-        int case_number = ceil(G4UniformRand()*3);
-        // APA 3x long supports
-        if (case_number == 1)
-        {
-            Ran_X = 0.0 *m  + G4UniformRand() * 0.10 *m;
-            Ran_Y = 0.15 *m + G4UniformRand() * (6 *m - 0.15*2 *m);
-        }
-        else if (case_number == 2 )
-        {
-            Ran_X = 1.10 *m + G4UniformRand() * 0.10 *m;
-            Ran_Y = 0.15 *m + G4UniformRand() * (6 *m - 0.15*2 *m);
-        }
-        else if (case_number == 3 )
-        {
-            Ran_X = 2.20 *m + G4UniformRand() * 0.10 *m;
-            Ran_Y = 0.15 *m + G4UniformRand() * (6 *m - 0.15*2 *m);
-        }
-    }
-    else if (case_weight >= 0.6 && case_weight <= 0.8)
-    {
-        int case_number = ceil(G4UniformRand()*2);
-        // APA header and footer
-        if (case_number == 1 )
-        {
-            Ran_X = G4UniformRand() * 2.3 *m;
-            Ran_Y = G4UniformRand() * 0.15 *m;
-        }
-        else if (case_number == 2 )
-        {
-            Ran_X = G4UniformRand() * 2.3 *m;
-            Ran_Y = 6 *m - G4UniformRand() * 0.15 *m;
-        }
-    }
-    else if (case_weight >= 0.8)
-    {
-        int case_number = ceil(G4UniformRand()*8);
-        // Now the 8x cross braces
-        if (case_number == 1 )
-        {
-            Ran_X = 0.10 *m + G4UniformRand() * 1.0 *m;
-            Ran_Y = 0.15 *m + 1.115*1 *m + G4UniformRand() * (0.05 *m);
-        }
-        else if (case_number == 2 )
-        {
-            Ran_X = 0.10 *m + G4UniformRand() * 1.0 *m;
-            Ran_Y = 0.15 *m + 1.115*2 *m + G4UniformRand() * (0.05 *m);
-        }
-        else if (case_number == 3 )
-        {
-            Ran_X = 0.10 *m + G4UniformRand() * 1.0 *m;
-            Ran_Y = 0.15 *m + 1.115*3 *m + G4UniformRand() * (0.05 *m);
-        }
-        else if (case_number == 4 )
-        {
-            Ran_X = 0.10 *m + G4UniformRand() * 1.0 *m;
-            Ran_Y = 0.15 *m + 1.115*4 *m + G4UniformRand() * (0.05 *m);
-        }
-        else if (case_number == 5 )
-        {
-            Ran_X = 1.20 *m + G4UniformRand() * 1.0 *m;
-            Ran_Y = 0.15 *m + 1.115*1 *m + G4UniformRand() * (0.05 *m);
-        }
-        else if (case_number == 6 )
-        {
-            Ran_X = 1.20 *m + G4UniformRand() * 1.0 *m;
-            Ran_Y = 0.15 *m + 1.115*2 *m + G4UniformRand() * (0.05 *m);
-        }
-        else if (case_number == 7 )
-        {
-            Ran_X = 1.20 *m + G4UniformRand() * 1.0 *m;
-            Ran_Y = 0.15 *m + 1.115*3 *m + G4UniformRand() * (0.05 *m);
-        }
-        else if (case_number == 8 )
-        {
-            Ran_X = 1.20 *m + G4UniformRand() * 1.0 *m;
-            Ran_Y = 0.15 *m + 1.115*4 *m + G4UniformRand() * (0.05 *m);
-        }
-    }  
-    
+    // uniform on the anode, the end face of the target at -z
+    const double r = target_radius_ * sqrt(u[0]);
+    const double phi = 2*M_PI * u[1];
+    Ran_X = r * cos(phi);
+    Ran_Y = r * sin(phi);
+    Ran_Z = -0.5 * target_length_ + 1 *um;
 }
 
 
 //-----------------------------------------------------------------------------
-inline void Supernova::Random_Direction(double& dx, double& dy, double& dz, const double length = 1.) 
+inline void Supernova::Random_Direction(double const* u, double& dx, double& dy, double& dz, const double length = 1.) 
 {
-    const double phi = 2*M_PI * G4UniformRand();
-    const double ctheta = 2 * G4UniformRand() - 1.;
+    const double phi = 2*M_PI * u[0];
+    const double ctheta = 2 * u[1] - 1.;
     const double stheta = sqrt(1. - ctheta * ctheta);
     dx = length * cos(phi) * stheta;
     dy = length * sin(phi) * stheta;
@@ -299,11 +322,9 @@ inline void Supernova::Random_Direction(double& dx, double& dy, double& dz, cons
 }
 
 //-----------------------------------------------------------------------------
-void Supernova::Get_Detector_Dimensions(double detector_x_, double detector_y_, double detector_z_)
+void Supernova::Set_Target(double Radius, double Length, double Mass)
 {
-    detector_length_x_ = detector_x_;
-    detector_length_y_ = detector_y_;
-    detector_length_z_ = detector_z_;
+    target_radius_ = Radius;
+    target_length_ = Length;
+    target_mass_ = Mass;
 }
-
-
@@ -12,7 +12,17 @@
 // #include "G4Box.hh"
 // #include "G4String.hh"
 
+#include "globals.hh"
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+class G4Event;
 class G4GenericMessenger;
+class G4ParticleDefinition;
 
 class Supernova {
 
@@ -20,29 +30,73 @@ class Supernova {
 
         Supernova();
         ~Supernova();
-        void Gen_Supernova_Background(G4Event*);
+        void Gen_Supernova_Background(G4Event*, int const Sub_Event = 0, int const N_Sub_Events = 1);
         void Gen_test_APA(G4Event*);
-        void Get_Detector_Dimensions(double detector_x_, double detector_y_, double detector_z_);
+
+        // radius, length and mass of the LAr target; the volume sources are
+        // spread over the target, the APA and CPA sources over its end faces
+        // at -z and +z, and the activities scale with its mass and end face
+        // area
+        void Set_Target(double Radius, double Length, double Mass);
+
+        inline int Sub_Events() const { return Sub_Events_; }
+        inline double Event_Window() const { return Event_Window_; }
+
+        // add a row "Z A Region N_Decays [Activity]" to the isotope source
+        // table; the regions are Vol, APA and CPA
+        void Add_Isotope(G4String const&);
+
+        // set the activity of the row "Z A Region Activity", adding the row
+        // if there is none; Bq/kg in the volume, Bq/m2 on the APA and CPA
+        void Set_Activity(G4String const&);
+
+        // add the rows of a file, one per line; # starts a comment
+        void Load_Isotopes(G4String const&);
+
+        // set all counts and activities to 0 and remove the added rows
+        void Clear_Isotopes();
 
     private:
         G4GenericMessenger* msg_; // Messenger for configuration parameters
         double Event_Window_;
-        int N_Ar39_Decays_;
-        int N_Ar42_Decays_;
-        int N_Kr85_Decays_;
-        int N_Co60_Decays_;
-        int N_K40_Decays_;
-        int N_K42_Decays_;
-        int N_Bi214_Decays_;
-        int N_Pb214_Decays_;
-        int N_Po210_Decays_;
-        int N_Rn222_Decays_;
-
-        double decay_time;
-        
-        double detector_length_x_;
-        double detector_length_y_;
-        double detector_length_z_;
+        int Sub_Events_;
+
+        // position sampler of a source region, mapping N_Randoms uniform
+        // numbers to a position
+        struct Sampler
+        {
+            int N_Randoms;
+            std::function< void(double const*, double&, double&, double&) > Sample;
+        };
+
+        // one row of the isotope source table; the ion definition is
+        // resolved at the first event, the sampler when the row is added.
+        // A row with an activity gets a Poisson number of decays in every
+        // window, otherwise exactly N_Decays.
+        struct Isotope_Source
+        {
+            int Atomic_Number;
+            int Atomic_Mass;
+            int N_Decays;
+            std::string Region;
+            Sampler Position;
+            G4ParticleDefinition* Ion;
+            double Activity;
+        };
+
+        // the ten built-in isotopes come first, with their N_*_Decays
+        // commands bound to their counts; a deque keeps those references
+        // valid as rows are added
+        std::deque< Isotope_Source > isotopes_;
+
+        std::map< std::string, Sampler > samplers_;
+
+        double target_radius_;
+        double target_length_;
+        double target_mass_;
+
+        // uniform numbers of a batch of decays, drawn at once
+        std::vector< double > randoms_;
 
         double Ran_X_;
         double Ran_Y_;
@@ -52,13 +106,25 @@ class Supernova {
         double Py_hat ;
         double Pz_hat ;
 
-        inline void Random_Direction(double& dx, double& dy, double& dz, const double length);
+        int Sub_Event_;
+        int N_Sub_Events_;
+
+        // number of the N_Decays decays of a readout window that fall in the current sub-event
+        int Decays_In_Sub_Event(int const N_Decays) const;
+
+        // mean number of decays of a source in the current sub-event
+        double Expected_Decays(Isotope_Source const& Source) const;
+
+        inline void Random_Direction(double const* u, double& dx, double& dy, double& dz, const double length);
+
+        // the positions take 2, 2 and 3 uniform numbers
+        void Gen_APA_Position(double const* u, double& Ran_X, double& Ran_Y, double& Ran_Z);
+        void Gen_CPA_Position(double const* u, double& Ran_X, double& Ran_Y, double& Ran_Z);
+        void Gen_Uniform_Position(double const* u, double& Ran_X, double& Ran_Y, double& Ran_Z);
 
-        void Gen_APA_Position(double& Ran_X, double& Ran_Y, double& Ran_Z);
-        void Gen_CPA_Position(double& Ran_X, double& Ran_Y, double& Ran_Z);
-        void Gen_Uniform_Position(double& Ran_X, double& Ran_Y, double& Ran_Z);
+        void Push_Isotope(int Atomic_Number, int Atomic_Mass, int N_Decays, std::string const& Region, double Activity = 0.);
 
-        void Generate_Radioisotope(G4Event* event, int Atomic_Number, int Atomic_Mass, double Decay_Time, std::string Region);
+        void Generate_Radioisotopes(G4Event* event, Isotope_Source const& Source, int N_Decays);
 
 };
 
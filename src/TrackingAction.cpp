@@ -9,10 +9,14 @@
 #include "TrackingAction.h"
 
 // Q-Pix includes
+#include "EventAction.h"
 #include "MCParticle.h"
 #include "MCTruthManager.h"
+#include "ProcessRegistry.h"
 
 // GEANT4 includes
+#include "G4EventManager.hh"
+#include "G4SystemOfUnits.hh"
 #include "G4TrackingManager.hh"
 
 // C++ includes
@@ -30,8 +34,8 @@ void TrackingAction::PreUserTrackingAction(const G4Track* track)
     // get MC truth manager
     MCTruthManager * mc_truth_manager = MCTruthManager::Instance();
 
-    // create new MCParticle object
-    MCParticle * particle = new MCParticle();
+    // create new MCParticle object in the event arena
+    MCParticle * particle = mc_truth_manager->NewMCParticle();
     particle->SetTrackID(track->GetTrackID());
     particle->SetParentTrackID(track->GetParentID());
     particle->SetPDGCode(track->GetDefinition()->GetPDGEncoding());
@@ -40,33 +44,30 @@ void TrackingAction::PreUserTrackingAction(const G4Track* track)
     particle->SetGlobalTime(track->GetGlobalTime() / CLHEP::ns);
     // particle->SetProcess();
     particle->SetTotalOccupancy(track->GetDynamicParticle()->GetTotalOccupancy());
+    particle->SetWeight(track->GetWeight());
 
     particle->SetInitialPosition(
-        TLorentzVector(
-            track->GetPosition().x() / CLHEP::cm,
-            track->GetPosition().y() / CLHEP::cm,
-            track->GetPosition().z() / CLHEP::cm,
-            track->GetGlobalTime()   / CLHEP::ns
-        )
+        track->GetPosition().x() / CLHEP::cm,
+        track->GetPosition().y() / CLHEP::cm,
+        track->GetPosition().z() / CLHEP::cm,
+        track->GetGlobalTime()   / CLHEP::ns
     );
 
     particle->SetInitialMomentum(
-        TLorentzVector(
-            track->GetMomentum().x() / CLHEP::MeV,
-            track->GetMomentum().y() / CLHEP::MeV,
-            track->GetMomentum().z() / CLHEP::MeV,
-            track->GetTotalEnergy()  / CLHEP::MeV
-        )
+        track->GetMomentum().x() / CLHEP::MeV,
+        track->GetMomentum().y() / CLHEP::MeV,
+        track->GetMomentum().z() / CLHEP::MeV,
+        track->GetTotalEnergy()  / CLHEP::MeV
     );
 
-    // add track ID to parent MC particle
+    // count the daughter in the parent MC particle
     // we might need to deal with cases where some particles aren't tracked (?)
     // we can use a try block for that if need be
     if (track->GetParentID() > 0)
     {
         // get parent MC particle
         MCParticle * parent_particle = mc_truth_manager->GetMCParticle(track->GetParentID());
-        parent_particle->AddDaughter(track->GetTrackID());
+        parent_particle->AddDaughter();
     }
 
     // add MC particle to MC truth manager
@@ -82,6 +83,18 @@ void TrackingAction::PostUserTrackingAction(const G4Track* track)
     MCParticle * particle = mc_truth_manager->GetMCParticle(track->GetTrackID());
 
     // set process
-    particle->SetProcess(track->GetStep()->GetPostStepPoint()->GetProcessDefinedStep()->GetProcessName());
+    particle->SetProcessKey(ProcessRegistry::Instance()->Key(track->GetStep()->GetPostStepPoint()->GetProcessDefinedStep()));
+
+    // the secondaries of the track are now waiting on the stack
+    G4TrackVector const * secondaries = fpTrackingManager->GimmeSecondaries();
+    mc_truth_manager->EndTrack(track->GetTrackID(), secondaries ? secondaries->size() : 0);
+
+    // write the finished part of the truth out when it takes too much memory
+    if (mc_truth_manager->MemoryLimitReached())
+    {
+        EventAction * event_action = static_cast< EventAction * >(
+            G4EventManager::GetEventManager()->GetUserEventAction());
+        event_action->WriteChunk();
+    }
 }
 
@@ -10,10 +10,12 @@
 #include "TrackingHit.h"
 
 // Q-Pix includes
+#include "DetectorConstruction.h"
 #include "MCTruthManager.h"
 #include "MCParticle.h"
 
 // GEANT4 includes
+#include "G4RunManager.hh"
 #include "G4SDManager.hh"
 #include "G4SystemOfUnits.hh"
 
@@ -23,7 +25,11 @@
 
 TrackingSD::TrackingSD(const G4String& sd_name, const G4String& hc_name):
   G4VSensitiveDetector(sd_name),
-  Event_Cutoff_(0.0)
+  Event_Cutoff_(0.0),
+  max_segment_length_(0.0),
+  max_segment_time_(0.0),
+  voxel_pitch_(0.0),
+  voxel_time_bin_(0.0)
   // hc_(nullptr)
 {
   collectionName.insert(hc_name);
@@ -31,12 +37,23 @@ TrackingSD::TrackingSD(const G4String& sd_name, const G4String& hc_name):
   msg_ = new G4GenericMessenger(this, "/Supernova/", "Control commands of the supernova generator.");
   msg_->DeclareProperty("Event_Cutoff", Event_Cutoff_,  "window to simulate the times").SetUnit("ns");
 
+  hits_msg_ = new G4GenericMessenger(this, "/hits/", "Control commands of the hit consolidation.");
+  hits_msg_->DeclareProperty("max_segment_length", max_segment_length_,
+      "Merge consecutive steps of a track into segments up to this length (0: no limit).").SetUnit("cm");
+  hits_msg_->DeclareProperty("max_segment_time", max_segment_time_,
+      "Merge consecutive steps of a track into segments up to this duration (0: no limit).").SetUnit("ns");
+  hits_msg_->DeclareProperty("voxel_pitch", voxel_pitch_,
+      "Sum the energy deposits over voxels of this pitch instead of writing hits (0: write hits).").SetUnit("mm");
+  hits_msg_->DeclareProperty("voxel_time_bin", voxel_time_bin_,
+      "Keep the deposits in a voxel apart by time bins of this width (0: one time bin).").SetUnit("ns");
+
 }
 
 
 TrackingSD::~TrackingSD()
 {
   delete msg_;
+  delete hits_msg_;
 }
 
 
@@ -50,6 +67,23 @@ TrackingSD::~TrackingSD()
 // }
 
 
+void TrackingSD::Initialize(G4HCofThisEvent*)
+{
+  if (voxel_pitch_ <= 0.) return;
+
+  // lay the voxel grid over the target, which may have been resized
+  DetectorConstruction const * detector_construction =
+    static_cast< DetectorConstruction const * >(
+      G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+
+  double const radius = detector_construction->GetTargetRadius();
+  double const length = detector_construction->GetTargetLength();
+
+  MCTruthManager::Instance()->GetVoxels().SetGrid(
+    -radius / cm, -radius / cm, -0.5 * length / cm, voxel_pitch_ / cm, voxel_time_bin_ / ns);
+}
+
+
 G4bool TrackingSD::ProcessHits(G4Step* aStep, G4TouchableHistory*)
 {
   G4double edep = aStep->GetTotalEnergyDeposit();
@@ -83,8 +117,34 @@ G4bool TrackingSD::ProcessHits(G4Step* aStep, G4TouchableHistory*)
   // get MC particle
   MCParticle * particle = mc_truth_manager->GetMCParticle(aStep->GetTrack()->GetTrackID());
 
-  // add hit to MC particle
-  particle->AddTrajectoryHit(aStep);
+  // in voxel mode only the energy is kept, summed over the voxel grid
+  if (voxel_pitch_ > 0.)
+  {
+    particle->AddEnergyDeposit(edep / MeV);
+    mc_truth_manager->GetVoxels().Add(aStep);
+    return true;
+  }
+
+  HitBuffer & hits = mc_truth_manager->GetHits();
+
+  // extend the last hit of the particle if this step continues it and the
+  // segment stays within the configured length and time
+  bool const consolidate = max_segment_length_ > 0. || max_segment_time_ > 0.;
+  bool const last_hit = particle->NumberHits() > 0 &&
+                        particle->FirstHit() + particle->NumberHits() == hits.Size();
+
+  if (consolidate && last_hit &&
+      hits.Extends(hits.Size() - 1, aStep, max_segment_length_ / cm, max_segment_time_ / ns))
+  {
+    hits.Extend(hits.Size() - 1, aStep);
+    particle->AddEnergyDeposit(edep / MeV);
+  }
+  else
+  {
+    // add hit to the event hit buffer and its index to the MC particle
+    particle->AddHit(hits.Size(), edep / MeV);
+    hits.Add(aStep);
+  }
 
   //---------------------------------------------------------------------------
   // end add hit to MCParticle
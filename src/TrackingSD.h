@@ -23,13 +23,30 @@ public:
   TrackingSD(const G4String&, const G4String&);
   virtual ~TrackingSD();
 
-  // virtual void   Initialize(G4HCofThisEvent*);
+  virtual void   Initialize(G4HCofThisEvent*);
   virtual G4bool ProcessHits(G4Step*, G4TouchableHistory*);
   // virtual void   EndOfEvent(G4HCofThisEvent*);
 
+  // hits later than this are dropped; 0 keeps all hits
+  inline double EventCutoff() const { return Event_Cutoff_; }
+
+  // voxel pitch and time bin of the voxel output mode; a pitch of 0 writes
+  // hits instead
+  inline double VoxelPitch()   const { return voxel_pitch_;    }
+  inline double VoxelTimeBin() const { return voxel_time_bin_; }
+
 private:
   // TrackingHitsCollection* hc_;
   G4GenericMessenger* msg_; // Messenger for configuration parameters
   double Event_Cutoff_;
+
+  // consecutive steps of a track are merged into segments no longer than
+  // these; consolidation is off while both are 0
+  G4GenericMessenger* hits_msg_;
+  double max_segment_length_;
+  double max_segment_time_;
+
+  double voxel_pitch_;
+  double voxel_time_bin_;
 };
 #endif
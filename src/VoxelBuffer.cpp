@@ -0,0 +1,219 @@
+// -----------------------------------------------------------------------------
+//  VoxelBuffer.cpp
+//
+//  Class definition of the voxel buffer
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#include "VoxelBuffer.h"
+
+// GEANT4 includes
+#include "G4SystemOfUnits.hh"
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+    // spread the lowest 21 bits of a voxel index over every third bit
+    inline ULong64_t Spread(ULong64_t x)
+    {
+        x &= 0x1fffff;
+        x = (x | x << 32) & 0x1f00000000ffffULL;
+        x = (x | x << 16) & 0x1f0000ff0000ffULL;
+        x = (x | x <<  8) & 0x100f00f00f00f00fULL;
+        x = (x | x <<  4) & 0x10c30c30c30c30c3ULL;
+        x = (x | x <<  2) & 0x1249249249249249ULL;
+        return x;
+    }
+
+    // voxel index of a coordinate, kept within the 21 bits of the key
+    inline uint32_t Index(double const x)
+    {
+        return std::min(std::max(std::floor(x), 0.), double(0x1fffff));
+    }
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+ULong64_t VoxelBuffer::MortonKey(uint32_t const ix, uint32_t const iy, uint32_t const iz)
+{
+    return Spread(ix) | Spread(iy) << 1 | Spread(iz) << 2;
+}
+
+//-----------------------------------------------------------------------------
+double VoxelBuffer::EnergyDeposit() const
+{
+    return std::accumulate(energy_deposit_.begin(), energy_deposit_.end(), 0.);
+}
+
+//-----------------------------------------------------------------------------
+void VoxelBuffer::SetGrid(double const x0, double const y0, double const z0,
+                          double const pitch, double const time_bin)
+{
+    x0_ = x0;
+    y0_ = y0;
+    z0_ = z0;
+    pitch_ = pitch;
+    time_bin_ = time_bin;
+}
+
+//-----------------------------------------------------------------------------
+void VoxelBuffer::Add(G4Step const * step)
+{
+    G4StepPoint const * pre_step_point = step->GetPreStepPoint();
+    G4StepPoint const * post_step_point = step->GetPostStepPoint();
+
+    G4ThreeVector const start = pre_step_point->GetPosition() / CLHEP::cm;
+    G4ThreeVector const end = post_step_point->GetPosition() / CLHEP::cm;
+    double const start_t = pre_step_point->GetGlobalTime() / CLHEP::ns;
+    double const end_t = post_step_point->GetGlobalTime() / CLHEP::ns;
+    double const energy = step->GetTotalEnergyDeposit() / CLHEP::MeV;
+    double const weight = pre_step_point->GetWeight();
+
+    // most steps are shorter than a voxel and go in one piece to their
+    // midpoint; longer ones are cut into pieces no longer than the pitch
+    int const pieces = std::max(1, int(std::ceil((end - start).mag() / pitch_)));
+
+    for (int piece = 0; piece < pieces; ++piece)
+    {
+        double const f = (piece + 0.5) / pieces;
+        G4ThreeVector const point = start + f * (end - start);
+        this->Deposit(point.x(), point.y(), point.z(), start_t + f * (end_t - start_t), energy / pieces, weight);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void VoxelBuffer::Deposit(double const x, double const y, double const z,
+                          double const t, double const energy, double const weight)
+{
+    Cell const cell = { MortonKey(Index((x - x0_) / pitch_),
+                                  Index((y - y0_) / pitch_),
+                                  Index((z - z0_) / pitch_)),
+                        time_bin_ > 0. ? int64_t(std::floor(t / time_bin_)) : 0 };
+
+    auto const inserted = index_.emplace(cell, key_.size());
+
+    if (inserted.second)
+    {
+        key_.push_back(cell.key);
+        energy_deposit_.push_back(0.);
+        t_.push_back(0.);
+        weight_.push_back(0.);
+    }
+
+    int const idx = inserted.first->second;
+
+    // the time and weight columns hold energy weighted sums until Finish()
+    energy_deposit_[idx] += energy;
+    t_[idx] += energy * t;
+    weight_[idx] += energy * weight;
+}
+
+//-----------------------------------------------------------------------------
+void VoxelBuffer::Finish()
+{
+    index_.clear();
+
+    for (size_t idx = 0; idx < t_.size(); ++idx)
+    {
+        if (energy_deposit_[idx] > 0.)
+        {
+            t_[idx] /= energy_deposit_[idx];
+            weight_[idx] /= energy_deposit_[idx];
+        }
+    }
+
+    this->Sort();
+}
+
+//-----------------------------------------------------------------------------
+void VoxelBuffer::Sort()
+{
+    // sort by key, then time, so that neighbouring voxels are close together
+    std::vector< int > order(key_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this] (int const a, int const b)
+    {
+        return key_[a] != key_[b] ? key_[a] < key_[b] : t_[a] < t_[b];
+    });
+
+    auto permute = [&order] (auto & column)
+    {
+        auto copy = column;
+        for (size_t idx = 0; idx < order.size(); ++idx) column[idx] = copy[order[idx]];
+    };
+
+    permute(key_);
+    permute(energy_deposit_);
+    permute(t_);
+    permute(weight_);
+}
+
+//-----------------------------------------------------------------------------
+void VoxelBuffer::Append(VoxelBuffer const & other, double const time_bin)
+{
+    key_.insert(key_.end(), other.key_.begin(), other.key_.end());
+    energy_deposit_.insert(energy_deposit_.end(), other.energy_deposit_.begin(), other.energy_deposit_.end());
+    t_.insert(t_.end(), other.t_.begin(), other.t_.end());
+    weight_.insert(weight_.end(), other.weight_.begin(), other.weight_.end());
+
+    this->Sort();
+
+    // the mean time of a voxel lies in its time bin, so after the sort the
+    // entries of one (key, time bin) are next to each other; fold each run
+    // of them into its first entry
+    auto bin = [time_bin] (double const t) { return time_bin > 0. ? int64_t(std::floor(t / time_bin)) : 0; };
+
+    size_t last = 0;
+    for (size_t idx = 1; idx < key_.size(); ++idx)
+    {
+        if (key_[idx] == key_[last] && bin(t_[idx]) == bin(t_[last]))
+        {
+            double const energy = energy_deposit_[last] + energy_deposit_[idx];
+            if (energy > 0.)
+            {
+                t_[last] = (energy_deposit_[last] * t_[last] + energy_deposit_[idx] * t_[idx]) / energy;
+                weight_[last] = (energy_deposit_[last] * weight_[last] + energy_deposit_[idx] * weight_[idx]) / energy;
+            }
+            energy_deposit_[last] = energy;
+            continue;
+        }
+
+        last += 1;
+        key_[last] = key_[idx];
+        energy_deposit_[last] = energy_deposit_[idx];
+        t_[last] = t_[idx];
+        weight_[last] = weight_[idx];
+    }
+
+    if (!key_.empty())
+    {
+        key_.resize(last + 1);
+        energy_deposit_.resize(last + 1);
+        t_.resize(last + 1);
+        weight_.resize(last + 1);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void VoxelBuffer::Branch(TTree * tree)
+{
+    tree->Branch("voxel_key",    &key_);
+    tree->Branch("voxel_edep",   &energy_deposit_);
+    tree->Branch("voxel_t",      &t_);
+    tree->Branch("voxel_weight", &weight_);
+}
+
+//-----------------------------------------------------------------------------
+void VoxelBuffer::Clear()
+{
+    index_.clear();
+    key_.clear();
+    energy_deposit_.clear();
+    t_.clear();
+    weight_.clear();
+}
@@ -0,0 +1,114 @@
+// -----------------------------------------------------------------------------
+//  VoxelBuffer.h
+//
+//  Class definition of the voxel buffer
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+#ifndef VoxelBuffer_h
+#define VoxelBuffer_h 1
+
+// GEANT4 includes
+#include "G4Step.hh"
+
+// ROOT includes
+#include "RtypesCore.h"
+#include "TTree.h"
+
+// C++ includes
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// energy deposited in one event, summed over a sparse grid of cubic voxels
+// laid over the target. A voxel is identified by the Morton key of its
+// indices (ix, iy, iz) along x, y and z, 21 bits each, counted from the
+// corner of the grid at (-radius, -radius, -length/2) of the target; its
+// centre is at corner + (i + 0.5) * pitch. With a time bin, deposits in the
+// same voxel but in different time bins are kept apart.
+struct VoxelBuffer
+{
+    // voxels sorted by key, then time; the time is the energy weighted mean
+    // time of the deposits in the voxel, and is only final after Finish().
+    // As for hits, the energy is not weighted in a biased run; the weight is
+    // the energy weighted mean statistical weight of the deposits, so that
+    // energy times weight is their weighted energy
+    std::vector< ULong64_t > key_;
+    std::vector< double >    energy_deposit_;
+    std::vector< double >    t_;
+    std::vector< double >    weight_;
+
+    inline int Size() const { return key_.size(); }
+
+    // memory taken by the voxels, counting a hash map node per voxel
+    inline size_t Bytes() const
+    {
+        return key_.size() * (sizeof(ULong64_t) + 3 * sizeof(double) + sizeof(Cell) + 2 * sizeof(void *));
+    }
+
+    // energy deposited in the voxels, in MeV
+    double EnergyDeposit() const;
+
+    // corner of the grid (cm), pitch (cm) and time bin (ns; 0 for none)
+    void SetGrid(double const, double const, double const, double const, double const);
+
+    // deposit the energy of a step, shared out along the step when it is
+    // longer than the pitch
+    void Add(G4Step const *);
+
+    // turn the accumulated sums into mean times and sort the voxels
+    void Finish();
+
+    // add the finished voxels of another buffer, with the given time bin
+    // (ns; 0 for none); a voxel in both buffers, in the same time bin, is
+    // summed into one entry, so the voxels stay unique and sorted
+    void Append(VoxelBuffer const &, double const);
+
+    // create the voxel_* branches of the event tree, bound to this buffer
+    void Branch(TTree *);
+
+    // clear the voxels, keeping the capacity
+    void Clear();
+
+    static ULong64_t MortonKey(uint32_t const, uint32_t const, uint32_t const);
+
+    //-------------------------------------------------------------------------
+    // accumulation
+    //-------------------------------------------------------------------------
+
+    struct Cell
+    {
+        ULong64_t key;
+        int64_t   time_bin;
+
+        bool operator==(Cell const & other) const
+        {
+            return key == other.key && time_bin == other.time_bin;
+        }
+    };
+
+    struct CellHash
+    {
+        size_t operator()(Cell const & cell) const
+        {
+            return std::hash< ULong64_t >()(cell.key * 0x9e3779b97f4a7c15ULL + cell.time_bin);
+        }
+    };
+
+    void Deposit(double const, double const, double const, double const, double const, double const);
+
+    // sort the columns by key, then time
+    void Sort();
+
+    // index of each occupied cell in the columns
+    std::unordered_map< Cell, int, CellHash > index_;
+
+    double x0_ = 0;
+    double y0_ = 0;
+    double z0_ = 0;
+    double pitch_ = 0;
+    double time_bin_ = 0;
+};
+
+#endif
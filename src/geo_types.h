@@ -6,6 +6,9 @@
 //   * Creation date: 10 August 2020
 // -----------------------------------------------------------------------------
 
+#ifndef geo_types_h
+#define geo_types_h 1
+
 // ROOT includes
 #include "Math/GenVector/CoordinateSystemTags.h"
 #include "Math/GenVector/Cartesian3D.h"
@@ -21,3 +24,14 @@ using Vector_t = ROOT::Math::DisplacementVector3D
        < ROOT::Math::Cartesian3D<double>,
          ROOT::Math::GlobalCoordinateSystemTag >;
 
+// storage type of the positions and momenta kept per particle and per hit;
+// times and energies are always stored in double precision, since a
+// supernova readout window is 10 s long and a float only resolves it to
+// about a microsecond
+#ifdef WITH_FLOAT_COORDINATES
+using Coordinate_t = float;
+#else
+using Coordinate_t = double;
+#endif
+
+#endif
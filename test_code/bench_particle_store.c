@@ -0,0 +1,166 @@
+// -----------------------------------------------------------------------------
+//  bench_particle_store.c
+//
+//  Microbenchmark of the MC particle store: the std::map< int, MCParticle * >
+//  that MCTruthManager used to keep against the vector indexed by track ID.
+//  The access pattern mimics one event: every track is added once in
+//  PreUserTrackingAction (with a lookup of its parent), looked up once in
+//  PostUserTrackingAction and once per hit in TrackingSD::ProcessHits, and
+//  the store is iterated in track ID order at the end of the event.
+//
+//  g++ -O2 -std=c++17 -o bench_particle_store bench_particle_store.c
+//  ./bench_particle_store [number of tracks] [hits per track]
+//
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+// C++ includes
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+//------------------------------------------------------------
+// stand-in for MCParticle
+//------------------------------------------------------------
+struct Particle
+{
+  int    track_id;
+  int    parent_track_id;
+  int    number_daughters = 0;
+  double energy_deposited = 0;
+};
+
+//------------------------------------------------------------
+// the two stores
+//------------------------------------------------------------
+struct MapStore
+{
+  std::map< int, Particle * > particles;
+
+  void Add(Particle * p) { particles[p->track_id] = p; }
+  Particle * Get(int const id)
+  {
+    if (particles.count(id) < 1) std::abort();
+    return particles.at(id);
+  }
+  template< typename F > void ForEach(F f) { for (auto const & p : particles) f(p.second); }
+};
+
+struct VectorStore
+{
+  std::vector< Particle * > particles;
+
+  void Add(Particle * p)
+  {
+    size_t const id = p->track_id;
+    if (id >= particles.size()) particles.resize(id + 1, nullptr);
+    particles[id] = p;
+  }
+  Particle * Get(int const id)
+  {
+    if (id < 0 || static_cast< size_t >(id) >= particles.size() || !particles[id]) std::abort();
+    return particles[id];
+  }
+  template< typename F > void ForEach(F f) { for (auto p : particles) if (p) f(p); }
+};
+
+//------------------------------------------------------------
+// one event
+//------------------------------------------------------------
+template< typename Store >
+double run_event(std::vector< Particle > & particles,
+                 std::vector< int > const & tracking_order,
+                 int const hits_per_track)
+{
+  auto const start = std::chrono::steady_clock::now();
+
+  Store store;
+  double sum = 0;
+
+  for (int const idx : tracking_order)
+  {
+    Particle * p = &particles[idx];
+    p->number_daughters = 0;
+    p->energy_deposited = 0;
+
+    // PreUserTrackingAction
+    if (p->parent_track_id > 0) store.Get(p->parent_track_id)->number_daughters++;
+    store.Add(p);
+
+    // TrackingSD::ProcessHits
+    for (int hit = 0; hit < hits_per_track; ++hit) store.Get(p->track_id)->energy_deposited += 1e-3;
+
+    // PostUserTrackingAction
+    store.Get(p->track_id);
+  }
+
+  // EventAction
+  store.ForEach([&sum] (Particle const * p) { sum += p->energy_deposited + p->number_daughters; });
+
+  auto const stop = std::chrono::steady_clock::now();
+
+  if (sum < 0) std::cout << sum << std::endl;
+
+  return std::chrono::duration< double >(stop - start).count();
+}
+
+//----------------------------------------------------------------------
+// main function
+//----------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  int const number_tracks  = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  int const hits_per_track = argc > 2 ? std::atoi(argv[2]) : 4;
+  int const repetitions = 5;
+
+  //----------------------------------------------------------
+  // build a random decay tree; Geant4 stacks secondaries and
+  // tracks them last-in first-out, so parents are tracked
+  // before their daughters but IDs are visited out of order
+  //----------------------------------------------------------
+  std::mt19937 rng(31);
+
+  std::vector< Particle > particles(number_tracks);
+  std::vector< std::vector< int > > daughters(number_tracks + 1);
+
+  for (int idx = 0; idx < number_tracks; ++idx)
+  {
+    particles[idx].track_id = idx + 1;
+    particles[idx].parent_track_id =
+        idx == 0 ? 0 : std::uniform_int_distribution< int >(1, idx)(rng);
+    daughters[particles[idx].parent_track_id].push_back(idx);
+  }
+
+  std::vector< int > tracking_order;
+  std::vector< int > stack(daughters[0].begin(), daughters[0].end());
+  while (!stack.empty())
+  {
+    int const idx = stack.back();
+    stack.pop_back();
+    tracking_order.push_back(idx);
+    for (int const d : daughters[idx + 1]) stack.push_back(d);
+  }
+
+  //----------------------------------------------------------
+  // time both stores
+  //----------------------------------------------------------
+  double map_time = 1e30;
+  double vector_time = 1e30;
+
+  for (int rep = 0; rep < repetitions; ++rep)
+  {
+    map_time    = std::min(map_time,    run_event< MapStore >(particles, tracking_order, hits_per_track));
+    vector_time = std::min(vector_time, run_event< VectorStore >(particles, tracking_order, hits_per_track));
+  }
+
+  std::cout << number_tracks << " tracks, " << hits_per_track << " hits per track\n"
+            << "  std::map    " << map_time    * 1e3 << " ms\n"
+            << "  std::vector " << vector_time * 1e3 << " ms\n"
+            << "  speed-up    " << map_time / vector_time << "x" << std::endl;
+
+  return 0;
+}
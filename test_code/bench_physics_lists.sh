@@ -0,0 +1,70 @@
+#!/bin/bash
+# -----------------------------------------------------------------------------
+#  bench_physics_lists.sh
+#
+#  Physics cost matrix: runs the bundled single-particle and supernova macros
+#  under each physics list and reports the startup time, the event rate and
+#  the peak memory. The startup time is that of the same macro with
+#  /run/beamOn 0, which still initializes the run and builds the physics
+#  tables; the event rate is taken over the rest of the wall time.
+#
+#  bench_physics_lists.sh <directionality01> <macros directory> [lists...]
+#
+#  The physics lists default to EM_RDM, FTFP_BERT_EMZ and FTFP_BERT_HP_EMZ.
+#
+#   * Author: Everybody is an author!
+#   * Creation date: 16 October 2026
+# -----------------------------------------------------------------------------
+
+EXE=$(realpath "$1")
+MACROS=$(realpath "$2")
+shift 2
+LISTS=${@:-EM_RDM FTFP_BERT_EMZ FTFP_BERT_HP_EMZ}
+
+# the macros refer to ../cfg and write to ../output
+WORK=$(mktemp -d)
+mkdir -p "${WORK}/run" "${WORK}/output"
+ln -s "${MACROS}/../cfg" "${WORK}/cfg"
+cd "${WORK}/run"
+
+# run a macro and print "<wall time in s> <peak memory in kB>"; measure runs
+# in a subshell, so the logs of failed runs are kept as files, and so is the
+# work directory holding them
+measure() {
+    if ! /usr/bin/time -f "%e %M" -o time.txt "${EXE}" --physics "$1" "$2" > log.txt 2>&1; then
+        LOG="failed_${NAME}_$1_$(basename "$2" .mac).log"
+        cp log.txt "${LOG}"
+        echo "failed: ${NAME} $1 $2, see ${WORK}/run/${LOG}" >&2
+    fi
+    cat time.txt
+}
+
+printf "%-36s %-18s %10s %10s %10s\n" "macro" "physics list" "startup/s" "events/s" "memory/MB"
+
+for MACRO in "${MACROS}"/single_*.mac "${MACROS}"/Template_Supernova_*.mac; do
+    NAME=$(basename "${MACRO}" .mac)
+    EVENTS=$(awk '/^\/run\/beamOn/ { n += $2 } END { print n + 0 }' "${MACRO}")
+
+    sed "s|^/Inputs/root_output .*|/Inputs/root_output ${WORK}/output/${NAME}.root|" "${MACRO}" > full.mac
+    sed "s|^/run/beamOn .*|/run/beamOn 0|" full.mac > startup.mac
+
+    for LIST in ${LISTS}; do
+        read STARTUP _ <<< "$(measure "${LIST}" startup.mac)"
+        read TOTAL MEMORY <<< "$(measure "${LIST}" full.mac)"
+
+        awk -v name="${NAME}" -v list="${LIST}" -v startup="${STARTUP}" -v total="${TOTAL}" \
+            -v events="${EVENTS}" -v memory="${MEMORY}" 'BEGIN {
+                loop = total - startup
+                printf "%-36s %-18s %10.2f %10.2f %10.1f\n", name, list, startup,
+                       (loop > 0 ? events / loop : 0), memory / 1024
+            }'
+    done
+done
+
+FAILED=$(ls failed_*.log 2> /dev/null | wc -l)
+if [ "${FAILED}" -gt 0 ]; then
+    echo "${FAILED} runs failed, their logs are in ${WORK}/run" >&2
+    exit 1
+fi
+
+rm -rf "${WORK}"
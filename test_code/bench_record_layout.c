@@ -0,0 +1,253 @@
+// -----------------------------------------------------------------------------
+//  bench_record_layout.c
+//
+//  Bytes per track and per hit of the MC truth records, before and after the
+//  compact layouts. The old MCParticle and TrajectoryHit are mirrored with
+//  stand-ins of the same size for the ROOT classes they used (TLorentzVector
+//  and PositionVector3D< Cartesian3D< double > >). Heap use is the number
+//  of live bytes allocated through operator new once one event of tracks
+//  and hits is built, and again once the hits are also in the output
+//  columns of the event record, which is the peak of the event. Live bytes
+//  include the spare capacity of the growing vectors.
+//
+//  g++ -O2 -std=c++17 -o bench_record_layout bench_record_layout.c
+//  ./bench_record_layout [number of tracks] [hits per track]
+//
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+// C++ includes
+#include <malloc.h>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------
+// heap accounting
+//------------------------------------------------------------
+static long heap_bytes = 0;
+
+// counts the usable size of each block, as malloc hands it out
+void * operator new(std::size_t size)
+{
+  void * p = std::malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  heap_bytes += malloc_usable_size(p);
+  return p;
+}
+
+void operator delete(void * p) noexcept
+{
+  if (p) heap_bytes -= malloc_usable_size(p);
+  std::free(p);
+}
+
+void operator delete(void * p, std::size_t) noexcept { operator delete(p); }
+
+//------------------------------------------------------------
+// stand-ins for the ROOT classes of the old layout
+//------------------------------------------------------------
+struct TObjectStandIn
+{
+  virtual ~TObjectStandIn() {}
+  unsigned unique_id = 0;
+  unsigned bits = 0;
+};
+
+struct TVector3StandIn : TObjectStandIn { double x = 0, y = 0, z = 0; };
+struct TLorentzVectorStandIn : TObjectStandIn { TVector3StandIn p; double e = 0; };
+struct Point3DStandIn { double x = 0, y = 0, z = 0; };
+
+//------------------------------------------------------------
+// old layout: AoS hits inside each particle, copied into the
+// output columns at the end of the event
+//------------------------------------------------------------
+struct OldTrajectoryHit
+{
+  Point3DStandIn start_;
+  Point3DStandIn end_;
+  double         energy_deposit_ = 0;
+  double         start_time_ = 0;
+  double         end_time_ = 0;
+  int            track_id_ = -1;
+  int            pdg_code_ = -1;
+  double         length_ = 0;
+  std::string    process_ = "unknown";
+};
+
+struct OldMCParticle
+{
+  int                           track_id_;
+  int                           parent_track_id_;
+  int                           pdg_code_;
+  double                        mass_;
+  double                        charge_;
+  double                        global_time_;
+  std::string                   process_;
+  int                           total_occupancy_;
+  double                        energy_deposited_ = 0.;
+  TLorentzVectorStandIn         initial_position_;
+  TLorentzVectorStandIn         initial_momentum_;
+  std::vector< OldTrajectoryHit > hits_;
+  int                           number_daughters_ = 0;
+  std::vector< int >            daughter_track_ids_;
+};
+
+//------------------------------------------------------------
+// new layout: POD particle and column-wise hits
+//------------------------------------------------------------
+template< typename Coordinate_t >
+struct NewMCParticle
+{
+  double       global_time_ = 0;
+  double       initial_t_ = 0;
+  double       energy_deposited_ = 0;
+  double       mass_ = 0;
+  double       initial_energy_ = 0;
+  Coordinate_t initial_x_ = 0, initial_y_ = 0, initial_z_ = 0;
+  Coordinate_t initial_px_ = 0, initial_py_ = 0, initial_pz_ = 0;
+  float        charge_ = 0;
+  int32_t      track_id_ = -1, parent_track_id_ = -1, pdg_code_ = 0, process_key_ = -1;
+  int32_t      total_occupancy_ = 0, first_hit_ = 0, number_hits_ = 0, number_daughters_ = 0;
+};
+
+template< typename Coordinate_t >
+struct HitColumns
+{
+  std::vector< int >          track_id_;
+  std::vector< Coordinate_t > start_x_, start_y_, start_z_, end_x_, end_y_, end_z_, length_;
+  std::vector< double >       start_t_, end_t_, energy_deposit_;
+  std::vector< int >          process_key_;
+
+  // bytes of one hit, summed over the columns
+  static constexpr std::size_t HitBytes()
+  {
+    return 2 * sizeof(int) + 7 * sizeof(Coordinate_t) + 3 * sizeof(double);
+  }
+
+  void Add(int const track_id)
+  {
+    track_id_.push_back(track_id);
+    start_x_.push_back(1); start_y_.push_back(1); start_z_.push_back(1); start_t_.push_back(1);
+    end_x_.push_back(1);   end_y_.push_back(1);   end_z_.push_back(1);   end_t_.push_back(1);
+    length_.push_back(1);  energy_deposit_.push_back(1);
+    process_key_.push_back(1);
+  }
+
+  void Reserve(std::size_t const n)
+  {
+    track_id_.reserve(n);
+    start_x_.reserve(n); start_y_.reserve(n); start_z_.reserve(n); start_t_.reserve(n);
+    end_x_.reserve(n);   end_y_.reserve(n);   end_z_.reserve(n);   end_t_.reserve(n);
+    length_.reserve(n);  energy_deposit_.reserve(n);
+    process_key_.reserve(n);
+  }
+};
+
+//------------------------------------------------------------
+// one event with each layout; returns the heap bytes held by
+// the truth, and at the peak once the output columns are filled
+//------------------------------------------------------------
+struct Usage { long truth; long peak; };
+
+Usage old_event(int const number_tracks, int const hits_per_track)
+{
+  long const start = heap_bytes;
+
+  std::vector< OldMCParticle * > particles(number_tracks + 1, nullptr);
+  for (int track_id = 1; track_id <= number_tracks; ++track_id)
+  {
+    OldMCParticle * particle = new OldMCParticle();
+    particle->track_id_ = track_id;
+    particle->parent_track_id_ = track_id / 2;
+    particle->process_ = "eIoni";
+    if (particle->parent_track_id_ > 0) particles[particle->parent_track_id_]->daughter_track_ids_.push_back(track_id);
+    for (int hit = 0; hit < hits_per_track; ++hit)
+    {
+      OldTrajectoryHit h;
+      h.track_id_ = track_id;
+      h.process_ = "eIoni";
+      particle->hits_.push_back(h);
+    }
+    particles[track_id] = particle;
+  }
+
+  long const truth = heap_bytes - start;
+
+  // the ~12 hit_* output vectors of the event record
+  HitColumns< double > output;
+  output.Reserve(std::size_t(number_tracks) * hits_per_track);
+
+  long const peak = heap_bytes - start;
+
+  for (auto particle : particles) delete particle;
+
+  return { truth, peak };
+}
+
+template< typename Coordinate_t >
+Usage new_event(int const number_tracks, int const hits_per_track)
+{
+  long const start = heap_bytes;
+
+  // the particles live in the event arena, one block for the event
+  std::vector< NewMCParticle< Coordinate_t > > arena(number_tracks);
+  std::vector< NewMCParticle< Coordinate_t > * > particles(number_tracks + 1, nullptr);
+  HitColumns< Coordinate_t > hits;
+
+  for (int track_id = 1; track_id <= number_tracks; ++track_id)
+  {
+    NewMCParticle< Coordinate_t > * particle = &arena[track_id - 1];
+    particle->track_id_ = track_id;
+    particle->parent_track_id_ = track_id / 2;
+    if (particle->parent_track_id_ > 0) particles[particle->parent_track_id_]->number_daughters_++;
+    particle->first_hit_ = hits.track_id_.size();
+    for (int hit = 0; hit < hits_per_track; ++hit) hits.Add(track_id);
+    particle->number_hits_ = hits_per_track;
+    particles[track_id] = particle;
+  }
+
+  long const truth = heap_bytes - start;
+
+  // the hit columns are swapped into the event record, not copied
+  return { truth, truth };
+}
+
+//----------------------------------------------------------------------
+// main function
+//----------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  int const number_tracks  = argc > 1 ? std::atoi(argv[1]) : 100000;
+  int const hits_per_track = argc > 2 ? std::atoi(argv[2]) : 10;
+
+  std::cout << "sizeof MCParticle:    old " << sizeof(OldMCParticle)
+            << ", new " << sizeof(NewMCParticle< double >)
+            << " (float coordinates " << sizeof(NewMCParticle< float >) << ") bytes\n"
+            << "sizeof TrajectoryHit: old " << sizeof(OldTrajectoryHit)
+            << ", new hit columns " << HitColumns< double >::HitBytes()
+            << " (float coordinates " << HitColumns< float >::HitBytes() << ") bytes\n\n";
+
+  // bytes per track with no hits, then bytes per hit from the difference
+  auto report = [&] (char const * name, auto event)
+  {
+    Usage const no_hits = event(number_tracks, 0);
+    Usage const with_hits = event(number_tracks, hits_per_track);
+    double const hits = double(number_tracks) * hits_per_track;
+    std::cout << name << ": "
+              << double(no_hits.truth) / number_tracks << " bytes/track, "
+              << double(with_hits.truth - no_hits.truth) / hits << " bytes/hit in the truth, "
+              << double(with_hits.peak - no_hits.peak) / hits << " bytes/hit at the event peak\n";
+  };
+
+  std::cout << number_tracks << " tracks, " << hits_per_track << " hits per track\n";
+  report("  old               ", old_event);
+  report("  new               ", new_event< double >);
+  report("  new, float coords ", new_event< float >);
+
+  return 0;
+}
@@ -0,0 +1,54 @@
+#!/bin/bash
+# -----------------------------------------------------------------------------
+#  check_fast_electron.sh
+#
+#  Energy check of the fast simulation of electrons: 100 keV electrons start
+#  in the middle of the target, where the model takes them over at once, so
+#  the hits of every event must add up to the kinetic energy of the primary.
+#
+#  check_fast_electron.sh <directionality01>
+#
+#  Run by ctest (fast_electron_energy).
+#
+#   * Author: Everybody is an author!
+#   * Creation date: 16 October 2026
+# -----------------------------------------------------------------------------
+
+EXE=$(realpath "$1")
+
+WORK=$(mktemp -d)
+cd "${WORK}"
+
+cat > check.mac <<MACRO
+/Inputs/root_output ${WORK}/check.root
+/run/initialize
+/fastsim/electron_energy 200 keV
+/fastsim/electron_segment_energy 10 keV
+/gps/particle e-
+/gps/pos/type Point
+/gps/pos/centre 0 0 0 cm
+/gps/direction 0 0 1
+/gps/ene/type Mono
+/gps/ene/mono 100 keV
+/run/beamOn 10
+MACRO
+
+if ! "${EXE}" --fast-electrons check.mac > log.txt 2>&1; then
+    echo "failed: see ${WORK}/log.txt" >&2
+    exit 1
+fi
+
+# number of events whose hit energy differs from 0.1 MeV
+BAD=$(root -l -b -q -e '
+    TFile file("check.root");
+    TTree * tree = (TTree *) file.Get("event_tree");
+    std::cout << "bad " << tree->GetEntries() - tree->GetEntries("abs(Sum$(hit_energy_deposit) - 0.1) < 1e-6") << std::endl;
+    ' 2>&1 | awk '/^bad/ { print $2 }')
+
+if [ "${BAD}" != "0" ]; then
+    echo "failed: ${BAD:-unknown number of} events where the hit energy is not the electron energy, see ${WORK}" >&2
+    exit 1
+fi
+
+echo "fast electron energy: ok"
+rm -rf "${WORK}"
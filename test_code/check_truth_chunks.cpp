@@ -0,0 +1,96 @@
+// -----------------------------------------------------------------------------
+//  check_truth_chunks.cpp
+//
+//  Regression check of the MC truth manager when the truth of an event is
+//  written in chunks. The event has several primaries; Geant4 tracks them
+//  last-in first-out, so the last primary and its descendants finish, and
+//  are released, before the earlier primaries are tracked at all. The slots
+//  of those primaries must survive every ReleaseClosed, and the memory they
+//  hold must not keep the memory limit reached once the closed particles
+//  are released.
+//
+//  Built and run by ctest (truth_chunks).
+//
+//   * Author: Everybody is an author!
+//   * Creation date: 16 October 2026
+// -----------------------------------------------------------------------------
+
+// Q-Pix includes
+#include "MCTruthManager.h"
+
+// C++ includes
+#include <iostream>
+#include <vector>
+
+//------------------------------------------------------------
+// stand-in for TrackingAction: a track with the given
+// number of secondaries, released whenever the memory limit,
+// of a single byte, is reached
+//------------------------------------------------------------
+static bool track(MCTruthManager * manager, int const track_id, int const parent_track_id,
+                  int const number_secondaries)
+{
+    MCParticle * particle = manager->NewMCParticle();
+    particle->SetTrackID(track_id);
+    particle->SetParentTrackID(parent_track_id);
+
+    if (parent_track_id > 0) manager->GetMCParticle(parent_track_id)->AddDaughter();
+    manager->AddMCParticle(particle);
+
+    manager->EndTrack(track_id, number_secondaries);
+    if (manager->MemoryLimitReached()) manager->ReleaseClosed();
+
+    if (manager->MemoryLimitReached())
+    {
+        std::cerr << "track " << track_id << ": memory limit still reached after release" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------
+// main function
+//----------------------------------------------------------------------
+int main()
+{
+    MCTruthManager * manager = MCTruthManager::Instance();
+    manager->SetMemoryLimit(1);
+
+    for (int event = 0; event < 2; ++event)
+    {
+        manager->EventReset();
+
+        // primaries 1 to 4; primary 2 is killed on the stack
+        manager->SetNumberPrimaries(4);
+        manager->DropTrack(2, 0);
+
+        // primary 4 with daughters 5 and 6, 6 with daughter 7
+        bool ok = track(manager, 4, 0, 2)
+               && track(manager, 6, 4, 1)
+               && track(manager, 7, 6, 0)
+               && track(manager, 5, 4, 0);
+
+        // primary 3 without daughters, primary 1 with daughter 8
+        ok = ok && track(manager, 3, 0, 0)
+                && track(manager, 1, 0, 1)
+                && track(manager, 8, 1, 0);
+        if (!ok) return 1;
+
+        manager->CloseAll();
+        manager->ReleaseClosed();
+
+        for (auto const particle : manager->GetMCParticles())
+        {
+            if (particle)
+            {
+                std::cerr << "event " << event << ": track " << particle->TrackID()
+                          << " was not released" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    std::cout << "truth chunks: ok" << std::endl;
+
+    return 0;
+}